@@ -0,0 +1,663 @@
+#pragma once
+#include "DCEL.h"
+#include <type_traits>
+
+/*
+
+Contains definition for a frozen, struct of arrays snapshot of a DCEL
+every element is renumbered into compact 32 bit indices, and its links are stored in parallel arrays
+the edges of each face loop are stored contiguously and in loop order, so walking a loop is a linear scan
+the read interface mirrors Point, Edge, Face, and Region through small view objects
+
+the snapshot is read only, it does not follow later changes to the source DCEL
+
+*/
+
+template <class _P>
+class Baked_DCEL {
+public:
+	typedef unsigned Index;
+
+	//marks a missing link, such as a face without a group
+	enum : Index { none = 0xffffffff };
+
+	class Point_View;
+	class Edge_View;
+	class Face_View;
+	class Region_View;
+
+private:
+	DCEL<_P> const * source;
+
+	int point_count;
+	int edge_count;
+	int face_count;
+	int region_count;
+
+	//points
+	_P * positions;
+	Index * point_root;
+	int * point_mark;
+
+	//edges, ordered face by face
+	Index * edge_next;
+	Index * edge_last;
+	Index * edge_inv;
+	Index * edge_face;
+	Index * edge_origin;
+	int * edge_mark;
+
+	//faces, the loop of face i is the edges [face_loop[i], face_loop[i + 1])
+	Index * face_loop;
+	Index * face_group;
+	int * face_mark;
+
+	//regions, the bounds of region i are region_bounds[region_bound_offset[i], region_bound_offset[i + 1])
+	Index * region_bound_offset;
+	Index * region_bounds;
+	int * region_mark;
+
+	//source handles to compact indices, sized by the source pools when baked
+	int point_capacity;
+	int edge_capacity;
+	int face_capacity;
+	int region_capacity;
+
+	Index * point_remap;
+	Index * edge_remap;
+	Index * face_remap;
+	Index * region_remap;
+
+	//the generation of every source slot when baked, a slot released since names another element
+	unsigned * point_generation;
+	unsigned * edge_generation;
+	unsigned * face_generation;
+	unsigned * region_generation;
+
+	template <class _T>
+	static _T * allocate(int count) {
+		return count > 0 ? new _T[count] : nullptr;
+	}
+
+	static Index * remap(int capacity) {
+		Index * product = allocate<Index>(capacity);
+
+		for (int index = 0; index < capacity; index++)
+			product[index] = none;
+
+		return product;
+	}
+
+	template <class _T, int _N>
+	static unsigned * generations(Pool<_T, _N> const & pool) {
+		unsigned * product = allocate<unsigned>(pool.capacity());
+
+		for (int handle = 0; handle < pool.capacity(); handle++)
+			product[handle] = pool.generationAt(handle);
+
+		return product;
+	}
+
+	static Index lookup(Index const * map, unsigned const * stamps, int capacity, unsigned handle, unsigned generation) {
+		return handle < (unsigned)capacity && stamps[handle] == generation ? map[handle] : (Index)none;
+	}
+
+	void release() {
+		delete[] positions;
+		delete[] point_root;
+		delete[] point_mark;
+
+		delete[] edge_next;
+		delete[] edge_last;
+		delete[] edge_inv;
+		delete[] edge_face;
+		delete[] edge_origin;
+		delete[] edge_mark;
+
+		delete[] face_loop;
+		delete[] face_group;
+		delete[] face_mark;
+
+		delete[] region_bound_offset;
+		delete[] region_bounds;
+		delete[] region_mark;
+
+		delete[] point_remap;
+		delete[] edge_remap;
+		delete[] face_remap;
+		delete[] region_remap;
+
+		delete[] point_generation;
+		delete[] edge_generation;
+		delete[] face_generation;
+		delete[] region_generation;
+	}
+
+	void empty() {
+		source = nullptr;
+
+		point_count = 0;
+		edge_count = 0;
+		face_count = 0;
+		region_count = 0;
+
+		positions = nullptr;
+		point_root = nullptr;
+		point_mark = nullptr;
+
+		edge_next = nullptr;
+		edge_last = nullptr;
+		edge_inv = nullptr;
+		edge_face = nullptr;
+		edge_origin = nullptr;
+		edge_mark = nullptr;
+
+		face_loop = nullptr;
+		face_group = nullptr;
+		face_mark = nullptr;
+
+		region_bound_offset = nullptr;
+		region_bounds = nullptr;
+		region_mark = nullptr;
+
+		point_remap = nullptr;
+		edge_remap = nullptr;
+		face_remap = nullptr;
+		region_remap = nullptr;
+
+		point_generation = nullptr;
+		edge_generation = nullptr;
+		face_generation = nullptr;
+		region_generation = nullptr;
+
+		point_capacity = 0;
+		edge_capacity = 0;
+		face_capacity = 0;
+		region_capacity = 0;
+	}
+
+	void take(Baked_DCEL<_P> & target) {
+		*this = static_cast<Baked_DCEL<_P> const &>(target);
+		target.empty();
+	}
+
+	//shallow, only used to move ownership
+	Baked_DCEL<_P> & operator=(Baked_DCEL<_P> const &) = default;
+
+public:
+
+	//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+	//         Views
+
+	//an iterator over a span of indices, _Fetch converts a position in the span to a view or value
+	template <class _Fetch>
+	class Span_Iterator {
+		Baked_DCEL const * universe;
+		Index focus;
+
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef typename std::decay<typename _Fetch::type>::type value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef value_type const * pointer;
+		typedef typename _Fetch::type reference;
+
+		Span_Iterator() {
+			universe = nullptr;
+			focus = 0;
+		}
+		Span_Iterator(Baked_DCEL const * u, Index f) {
+			universe = u;
+			focus = f;
+		}
+
+		Span_Iterator & operator++() {
+			focus++;
+			return *this;
+		}
+		Span_Iterator operator++(int) {
+			Span_Iterator product(*this);
+			focus++;
+			return product;
+		}
+		bool operator==(Span_Iterator const & target) const {
+			return focus == target.focus;
+		}
+		bool operator!=(Span_Iterator const & target) const {
+			return focus != target.focus;
+		}
+
+		reference operator*() const {
+			return _Fetch::get(universe, focus);
+		}
+	};
+
+	template <class _Fetch>
+	class Span {
+		Baked_DCEL const * universe;
+		Index first;
+		Index last;
+
+	public:
+		typedef Span_Iterator<_Fetch> iterator;
+
+		Span(Baked_DCEL const * u, Index f, Index l) {
+			universe = u;
+			first = f;
+			last = l;
+		}
+
+		iterator begin() const {
+			return iterator(universe, first);
+		}
+		iterator end() const {
+			return iterator(universe, last);
+		}
+		int size() const {
+			return (int)(last - first);
+		}
+	};
+
+	struct Fetch_Edge {
+		typedef Edge_View type;
+		static Edge_View get(Baked_DCEL const * universe, Index focus) {
+			return Edge_View(universe, focus);
+		}
+	};
+	struct Fetch_Position {
+		typedef _P const & type;
+		static _P const & get(Baked_DCEL const * universe, Index focus) {
+			return universe->positions[universe->edge_origin[focus]];
+		}
+	};
+	struct Fetch_Bound {
+		typedef Face_View type;
+		static Face_View get(Baked_DCEL const * universe, Index focus) {
+			return Face_View(universe, universe->region_bounds[focus]);
+		}
+	};
+
+	//views are two words, and are passed by value
+	//a view of a missing element (none) converts to false
+	class Point_View {
+		Baked_DCEL const * universe;
+		Index index;
+
+	public:
+		Point_View(Baked_DCEL const * u, Index i) {
+			universe = u;
+			index = i;
+		}
+
+		explicit operator bool() const {
+			return index != none;
+		}
+		bool operator==(Point_View const & target) const {
+			return index == target.index;
+		}
+		bool operator!=(Point_View const & target) const {
+			return index != target.index;
+		}
+		Index getIndex() const {
+			return index;
+		}
+
+		_P const & getPosition() const {
+			return universe->positions[index];
+		}
+		Edge_View getRoot() const {
+			return Edge_View(universe, universe->point_root[index]);
+		}
+		int getMark() const {
+			return universe->point_mark[index];
+		}
+	};
+
+	class Edge_View {
+		Baked_DCEL const * universe;
+		Index index;
+
+	public:
+		Edge_View(Baked_DCEL const * u, Index i) {
+			universe = u;
+			index = i;
+		}
+
+		explicit operator bool() const {
+			return index != none;
+		}
+		bool operator==(Edge_View const & target) const {
+			return index == target.index;
+		}
+		bool operator!=(Edge_View const & target) const {
+			return index != target.index;
+		}
+		Index getIndex() const {
+			return index;
+		}
+
+		Point_View getStart() const {
+			return Point_View(universe, universe->edge_origin[index]);
+		}
+		Point_View getEnd() const {
+			return Point_View(universe, universe->edge_origin[universe->edge_inv[index]]);
+		}
+		Edge_View getNext() const {
+			return Edge_View(universe, universe->edge_next[index]);
+		}
+		Edge_View getLast() const {
+			return Edge_View(universe, universe->edge_last[index]);
+		}
+		Edge_View getInv() const {
+			return Edge_View(universe, universe->edge_inv[index]);
+		}
+		Face_View getFace() const {
+			return Face_View(universe, universe->edge_face[index]);
+		}
+		//get the next edge cw around the root
+		Edge_View getCW() const {
+			return getLast().getInv();
+		}
+		//get the next edge ccw around the root
+		Edge_View getCCW() const {
+			return getInv().getNext();
+		}
+		int getMark() const {
+			return universe->edge_mark[index];
+		}
+	};
+
+	class Face_View {
+		Baked_DCEL const * universe;
+		Index index;
+
+	public:
+		Face_View(Baked_DCEL const * u, Index i) {
+			universe = u;
+			index = i;
+		}
+
+		explicit operator bool() const {
+			return index != none;
+		}
+		bool operator==(Face_View const & target) const {
+			return index == target.index;
+		}
+		bool operator!=(Face_View const & target) const {
+			return index != target.index;
+		}
+		Index getIndex() const {
+			return index;
+		}
+
+		Edge_View getRoot() const {
+			return Edge_View(universe, universe->face_loop[index]);
+		}
+		Region_View getGroup() const {
+			return Region_View(universe, universe->face_group[index]);
+		}
+		int getLoopSize() const {
+			return (int)(universe->face_loop[index + 1] - universe->face_loop[index]);
+		}
+		int getMark() const {
+			return universe->face_mark[index];
+		}
+
+		//the edges of the loop, starting at the root
+		Span<Fetch_Edge> loopEdges() const {
+			return Span<Fetch_Edge>(universe, universe->face_loop[index], universe->face_loop[index + 1]);
+		}
+		//the points of the loop, starting at the root's start
+		Span<Fetch_Position> loopPoints() const {
+			return Span<Fetch_Position>(universe, universe->face_loop[index], universe->face_loop[index + 1]);
+		}
+	};
+
+	class Region_View {
+		Baked_DCEL const * universe;
+		Index index;
+
+	public:
+		Region_View(Baked_DCEL const * u, Index i) {
+			universe = u;
+			index = i;
+		}
+
+		explicit operator bool() const {
+			return index != none;
+		}
+		bool operator==(Region_View const & target) const {
+			return index == target.index;
+		}
+		bool operator!=(Region_View const & target) const {
+			return index != target.index;
+		}
+		Index getIndex() const {
+			return index;
+		}
+
+		Span<Fetch_Bound> getBounds() const {
+			return Span<Fetch_Bound>(universe, universe->region_bound_offset[index], universe->region_bound_offset[index + 1]);
+		}
+		Face_View operator[](int a) const {
+			return Face_View(universe, universe->region_bounds[universe->region_bound_offset[index] + a]);
+		}
+		int getMark() const {
+			return universe->region_mark[index];
+		}
+	};
+
+	//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+	//         Construction
+
+	Baked_DCEL() {
+		empty();
+	}
+
+	Baked_DCEL(DCEL<_P> const & target) {
+		empty();
+
+		source = &target;
+
+		point_count = target.points.size();
+		edge_count = target.edges.size();
+		face_count = target.faces.size();
+		region_count = target.regions.size();
+
+		point_capacity = target.points.capacity();
+		edge_capacity = target.edges.capacity();
+		face_capacity = target.faces.capacity();
+		region_capacity = target.regions.capacity();
+
+		point_remap = remap(point_capacity);
+		edge_remap = remap(edge_capacity);
+		face_remap = remap(face_capacity);
+		region_remap = remap(region_capacity);
+
+		point_generation = generations(target.points);
+		edge_generation = generations(target.edges);
+		face_generation = generations(target.faces);
+		region_generation = generations(target.regions);
+
+		//number faces and regions in pool order
+		{
+			Index next = 0;
+			for (auto face : target.faces)
+				face_remap[target.faces.handleOf(face)] = next++;
+
+			next = 0;
+			for (auto region : target.regions)
+				region_remap[target.regions.handleOf(region)] = next++;
+		}
+
+		//number edges loop by loop, and points by first appearance as an edge root
+		face_loop = allocate<Index>(face_count + 1);
+		face_group = allocate<Index>(face_count);
+		face_mark = allocate<int>(face_count);
+
+		edge_origin = allocate<Index>(edge_count);
+		edge_face = allocate<Index>(edge_count);
+		edge_mark = allocate<int>(edge_count);
+
+		positions = allocate<_P>(point_count);
+		point_root = allocate<Index>(point_count);
+		point_mark = allocate<int>(point_count);
+
+		{
+			Index face_index = 0;
+			Index edge_index = 0;
+			Index point_index = 0;
+
+			for (auto face : target.faces) {
+				face_loop[face_index] = edge_index;
+				face_group[face_index] = face->getGroup() == nullptr ? (Index)none :
+					region_remap[target.regions.handleOf(face->getGroup())];
+				face_mark[face_index] = face->getMark();
+
+				for (auto edge : face->loopEdges()) {
+					edge_remap[target.edges.handleOf(edge)] = edge_index;
+
+					auto point = edge->getStart();
+					Index & point_slot = point_remap[target.points.handleOf(point)];
+					if (point_slot == none) {
+						point_slot = point_index;
+
+						positions[point_index] = point->getPosition();
+						point_mark[point_index] = point->getMark();
+
+						point_index++;
+					}
+
+					edge_origin[edge_index] = point_slot;
+					edge_face[edge_index] = face_index;
+					edge_mark[edge_index] = edge->getMark();
+
+					edge_index++;
+				}
+
+				face_index++;
+			}
+
+			face_loop[face_index] = edge_index;
+
+			//points with no edges are kept, at the end
+			for (auto point : target.points) {
+				Index & point_slot = point_remap[target.points.handleOf(point)];
+				if (point_slot == none) {
+					point_slot = point_index;
+
+					positions[point_index] = point->getPosition();
+					point_mark[point_index] = point->getMark();
+
+					point_index++;
+				}
+			}
+		}
+
+		//links, now that every element is numbered
+		edge_next = allocate<Index>(edge_count);
+		edge_last = allocate<Index>(edge_count);
+		edge_inv = allocate<Index>(edge_count);
+
+		for (auto edge : target.edges) {
+			Index const index = edge_remap[target.edges.handleOf(edge)];
+
+			edge_next[index] = edge_remap[target.edges.handleOf(edge->getNext())];
+			edge_last[index] = edge_remap[target.edges.handleOf(edge->getLast())];
+			edge_inv[index] = edge_remap[target.edges.handleOf(edge->getInv())];
+		}
+
+		for (auto point : target.points) {
+			Index const index = point_remap[target.points.handleOf(point)];
+
+			point_root[index] = point->getRoot() == nullptr ? (Index)none :
+				edge_remap[target.edges.handleOf(point->getRoot())];
+		}
+
+		region_bound_offset = allocate<Index>(region_count + 1);
+		{
+			int bound_count = 0;
+			for (auto region : target.regions)
+				bound_count += region->getBounds().size();
+
+			region_bounds = allocate<Index>(bound_count);
+			region_mark = allocate<int>(region_count);
+
+			Index region_index = 0;
+			Index bound_index = 0;
+
+			for (auto region : target.regions) {
+				region_bound_offset[region_index] = bound_index;
+				region_mark[region_index] = region->getMark();
+
+				for (auto face : region->getBounds())
+					region_bounds[bound_index++] = face_remap[target.faces.handleOf(face)];
+
+				region_index++;
+			}
+
+			region_bound_offset[region_index] = bound_index;
+		}
+	}
+
+	~Baked_DCEL() {
+		release();
+	}
+
+	Baked_DCEL(Baked_DCEL<_P> && target) {
+		empty();
+		take(target);
+	}
+
+	Baked_DCEL(Baked_DCEL<_P> const &) = delete;
+
+	//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+	//         Access
+
+	int pointCount() const {
+		return point_count;
+	}
+	int edgeCount() const {
+		return edge_count;
+	}
+	int faceCount() const {
+		return face_count;
+	}
+	int regionCount() const {
+		return region_count;
+	}
+
+	Point_View point(Index index) const {
+		return Point_View(this, index);
+	}
+	Edge_View edge(Index index) const {
+		return Edge_View(this, index);
+	}
+	Face_View face(Index index) const {
+		return Face_View(this, index);
+	}
+	Region_View region(Index index) const {
+		return Region_View(this, index);
+	}
+
+	//finds the view of an element of the source DCEL, the view is missing if it did not exist when baked
+	//an element created since, in the slot of one that was baked, is missing too
+	//the source DCEL must still be alive
+	Point_View find(Point<_P> const * target) const {
+		return Point_View(this, lookup(point_remap, point_generation, point_capacity, source->getHandle(target), source->getGeneration(target)));
+	}
+	Edge_View find(Edge<_P> const * target) const {
+		return Edge_View(this, lookup(edge_remap, edge_generation, edge_capacity, source->getHandle(target), source->getGeneration(target)));
+	}
+	Face_View find(Face<_P> const * target) const {
+		return Face_View(this, lookup(face_remap, face_generation, face_capacity, source->getHandle(target), source->getGeneration(target)));
+	}
+	Region_View find(Region<_P> const * target) const {
+		return Region_View(this, lookup(region_remap, region_generation, region_capacity, source->getHandle(target), source->getGeneration(target)));
+	}
+
+	//the packed positions, indexed by point
+	_P const * getPositions() const {
+		return positions;
+	}
+};
@@ -1,5 +1,10 @@
 #pragma once
 #include "FLL.h"
+#include "SVL.h"
+#include "Pool.h"
+#include <cstddef>
+#include <iterator>
+#include <utility>
 
 /*
 
@@ -14,6 +19,262 @@ template <class _P> class Edge;
 template <class _P> class Face;
 template <class _P> class Region;
 template <class _P> class DCEL;
+template <class _P> class Baked_DCEL;
+
+//the geometry caches of faces and edges are laid out using the coordinate type of _P
+//they are only computed on request, which needs X and Y, subtraction, Size(), Normalize(),
+//and a static area over a range of points
+template <class _P>
+struct Geometry_Traits {
+	typedef decltype(std::declval<_P const &>().X) scalar;
+};
+
+//a user mark that reads as zero once the epoch it was written in has been retired
+//this lets a DCEL clear every mark of a kind by advancing a counter, rather than sweeping elements
+class Epoch_Mark {
+	int value;
+	unsigned epoch;
+
+public:
+	Epoch_Mark() {
+		value = 0;
+		epoch = 0;
+	}
+
+	int get(unsigned current) const {
+		return epoch == current ? value : 0;
+	}
+	void set(int v, unsigned current) {
+		value = v;
+		epoch = current;
+	}
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//         Traversal Ranges
+
+//lazy ranges over the cycles of a DCEL, usable with range-for and standard algorithms
+//nothing is allocated, the cycle is walked as the range is iterated
+//the structure must not be modified while a range over it is in use
+
+//steps to the next edge of the same face
+struct Loop_Step {
+	template <class _E>
+	static _E * step(_E * focus) {
+		return focus->getNext();
+	}
+};
+
+//steps to the next edge ccw around the same root point
+struct Star_Step {
+	template <class _E>
+	static _E * step(_E * focus) {
+		return focus->getCCW();
+	}
+};
+
+template <class _E, class _Step>
+class Cycle_Iterator {
+	_E * root;
+	_E * focus;
+	int lap;
+
+public:
+	typedef std::forward_iterator_tag iterator_category;
+	typedef _E * value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef _E * const * pointer;
+	typedef _E * const & reference;
+
+	Cycle_Iterator() {
+		root = nullptr;
+		focus = nullptr;
+		lap = 1;
+	}
+	Cycle_Iterator(_E * r, int l) {
+		root = r;
+		focus = r;
+		lap = r == nullptr ? 1 : l;
+	}
+
+	Cycle_Iterator & operator++() {
+		focus = _Step::step(focus);
+		if (focus == root)
+			lap++;
+
+		return *this;
+	}
+	Cycle_Iterator operator++(int) {
+		Cycle_Iterator product(*this);
+		++(*this);
+		return product;
+	}
+	bool operator==(Cycle_Iterator const & target) const {
+		return lap == target.lap && (lap != 0 || focus == target.focus);
+	}
+	bool operator!=(Cycle_Iterator const & target) const {
+		return !(*this == target);
+	}
+
+	reference operator*() const {
+		return focus;
+	}
+};
+
+template <class _E, class _Step>
+class Cycle_Range {
+	_E * root;
+
+public:
+	typedef Cycle_Iterator<_E, _Step> iterator;
+
+	Cycle_Range(_E * r) {
+		root = r;
+	}
+
+	iterator begin() const {
+		return iterator(root, 0);
+	}
+	iterator end() const {
+		return iterator(root, 1);
+	}
+};
+
+//iterates the positions at the start of each edge in a loop
+template <class _P>
+class Loop_Point_Iterator {
+	Cycle_Iterator<Edge<_P> const, Loop_Step> focus;
+
+public:
+	typedef std::forward_iterator_tag iterator_category;
+	typedef _P value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef _P const * pointer;
+	typedef _P const & reference;
+
+	Loop_Point_Iterator() {
+
+	}
+	Loop_Point_Iterator(Cycle_Iterator<Edge<_P> const, Loop_Step> const & f) {
+		focus = f;
+	}
+
+	Loop_Point_Iterator & operator++() {
+		++focus;
+		return *this;
+	}
+	Loop_Point_Iterator operator++(int) {
+		Loop_Point_Iterator product(*this);
+		++focus;
+		return product;
+	}
+	bool operator==(Loop_Point_Iterator const & target) const {
+		return focus == target.focus;
+	}
+	bool operator!=(Loop_Point_Iterator const & target) const {
+		return focus != target.focus;
+	}
+
+	reference operator*() const {
+		return (*focus)->getStart()->getPosition();
+	}
+};
+
+template <class _P>
+class Loop_Point_Range {
+	Edge<_P> const * root;
+
+public:
+	typedef Loop_Point_Iterator<_P> iterator;
+
+	Loop_Point_Range(Edge<_P> const * r) {
+		root = r;
+	}
+
+	iterator begin() const {
+		return iterator(Cycle_Iterator<Edge<_P> const, Loop_Step>(root, 0));
+	}
+	iterator end() const {
+		return iterator(Cycle_Iterator<Edge<_P> const, Loop_Step>(root, 1));
+	}
+};
+
+//iterates every edge of every boundary of a region, face by face
+template <class _P, class _E>
+class Boundary_Edge_Iterator {
+	Face<_P> * const * bound;
+	Face<_P> * const * bound_end;
+	_E * focus;
+
+	void enter() {
+		focus = bound != bound_end ? (*bound)->getRoot() : nullptr;
+	}
+
+public:
+	typedef std::forward_iterator_tag iterator_category;
+	typedef _E * value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef _E * const * pointer;
+	typedef _E * const & reference;
+
+	Boundary_Edge_Iterator() {
+		bound = nullptr;
+		bound_end = nullptr;
+		focus = nullptr;
+	}
+	Boundary_Edge_Iterator(Face<_P> * const * b, Face<_P> * const * e) {
+		bound = b;
+		bound_end = e;
+		enter();
+	}
+
+	Boundary_Edge_Iterator & operator++() {
+		focus = focus->getNext();
+
+		if (focus == (*bound)->getRoot()) {
+			++bound;
+			enter();
+		}
+
+		return *this;
+	}
+	Boundary_Edge_Iterator operator++(int) {
+		Boundary_Edge_Iterator product(*this);
+		++(*this);
+		return product;
+	}
+	bool operator==(Boundary_Edge_Iterator const & target) const {
+		return bound == target.bound && focus == target.focus;
+	}
+	bool operator!=(Boundary_Edge_Iterator const & target) const {
+		return !(*this == target);
+	}
+
+	reference operator*() const {
+		return focus;
+	}
+};
+
+template <class _P, class _E>
+class Boundary_Edge_Range {
+	Face<_P> * const * bound;
+	Face<_P> * const * bound_end;
+
+public:
+	typedef Boundary_Edge_Iterator<_P, _E> iterator;
+
+	Boundary_Edge_Range(Face<_P> * const * b, Face<_P> * const * e) {
+		bound = b;
+		bound_end = e;
+	}
+
+	iterator begin() const {
+		return iterator(bound, bound_end);
+	}
+	iterator end() const {
+		return iterator(bound_end, bound_end);
+	}
+};
 
 // Represents a point in space, the ends of edges, and corners of faces
 template <class _P>
@@ -35,7 +296,7 @@ class Point {
 	Point(DCEL<_P> * uni){
 		universe = uni;
 
-		mark = 0;
+		visit_stamp = 0;
 	};
 	Point(Point<_P> &&) = delete;
 	Point(Point<_P> const &) = delete;
@@ -43,13 +304,39 @@ class Point {
 	~Point() {
 
 	}
+	// visitation stamp, see DCEL::beginTraversal
+	mutable unsigned visit_stamp;
+
+	Epoch_Mark mark;
+
 public:
-	int mark;
+	int getMark() const {
+		return mark.get(universe->point_mark_epoch);
+	}
+	void setMark(int value) {
+		mark.set(value, universe->point_mark_epoch);
+	}
+
+	//test-and-set, returns true only the first time this is visited within the traversal epoch
+	bool visit(unsigned epoch) const {
+		if (visit_stamp == epoch)
+			return false;
+
+		visit_stamp = epoch;
+		return true;
+	}
+	bool visited(unsigned epoch) const {
+		return visit_stamp == epoch;
+	}
 
 	void setPosition(_P p) {
 		position = p;
+
+		if (root != nullptr)
+			for (auto edge : starEdges())
+				edge->invalidateGeometry();
 	};
-	_P getPosition() const {
+	_P const & getPosition() const {
 		return position;
 	};
 
@@ -63,6 +350,15 @@ public:
 	Edge<_P> const * getRoot() const {
 		return root;
 	}
+
+	//the edges leaving this point, in ccw order
+	Cycle_Range<Edge<_P>, Star_Step> starEdges() {
+		return Cycle_Range<Edge<_P>, Star_Step>(root);
+	}
+
+	Cycle_Range<Edge<_P> const, Star_Step> starEdges() const {
+		return Cycle_Range<Edge<_P> const, Star_Step>(root);
+	}
 };
 
 enum EdgeModType { face_destroyed, faces_preserved, face_created};
@@ -87,6 +383,7 @@ class Edge {
 	//friend Face;
 	friend DCEL<_P>;
 	friend Face<_P>;
+	friend Point<_P>;
 
 	// The associated DCEL system
 	DCEL<_P> * universe;
@@ -108,7 +405,8 @@ class Edge {
 	Edge(DCEL<_P> * uni) {
 		universe = uni;
 
-		mark = 0;
+		visit_stamp = 0;
+		geometry_valid = false;
 	}
 	Edge(Edge<_P> &&) = delete;
 	Edge(Edge<_P> const &) = delete;
@@ -116,8 +414,59 @@ class Edge {
 	~Edge() {
 
 	}
+	// visitation stamp, see DCEL::beginTraversal
+	mutable unsigned visit_stamp;
+
+	Epoch_Mark mark;
+
+	//cached geometry, refreshed on request after any mutation that moves either end
+	mutable _P vector_cache;
+	mutable _P direction_cache;
+	mutable typename Geometry_Traits<_P>::scalar length_cache;
+	mutable bool geometry_valid;
+
+	void refreshGeometry() const {
+		if (geometry_valid)
+			return;
+
+		vector_cache = inv->root->position - root->position;
+		length_cache = vector_cache.Size();
+
+		direction_cache = vector_cache;
+		direction_cache.Normalize();
+
+		geometry_valid = true;
+	}
+
+	//marks this edge, its inverse, and the faces on either side as stale
+	//the faces must already be assigned
+	void invalidateGeometry() {
+		geometry_valid = false;
+		inv->geometry_valid = false;
+
+		loop->geometry_valid = false;
+		inv->loop->geometry_valid = false;
+	}
+
 public:
-	int mark;
+	int getMark() const {
+		return mark.get(universe->edge_mark_epoch);
+	}
+	void setMark(int value) {
+		mark.set(value, universe->edge_mark_epoch);
+	}
+
+	//test-and-set, returns true only the first time this is visited within the traversal epoch
+	bool visit(unsigned epoch) const {
+		if (visit_stamp == epoch)
+			return false;
+
+		visit_stamp = epoch;
+		return true;
+	}
+	bool visited(unsigned epoch) const {
+		return visit_stamp == epoch;
+	}
 
 	//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 	//         Traversal Methods
@@ -175,11 +524,29 @@ public:
 
 	//get the next edge cw around the root
 	Edge<_P> const * getCW() const {
-		return inv->next;
+		return last->inv;
 	}
 	//get the next edge ccw around the root
 	Edge<_P> const * getCCW() const {
-		return last->inv;
+		return inv->next;
+	}
+
+	//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+	//         Geometry
+
+	//the offset from start to end
+	_P const & getVector() const {
+		refreshGeometry();
+		return vector_cache;
+	}
+	//the offset from start to end, normalized
+	_P const & getDirection() const {
+		refreshGeometry();
+		return direction_cache;
+	}
+	typename Geometry_Traits<_P>::scalar const & getLength() const {
+		refreshGeometry();
+		return length_cache;
 	}
 
 	//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -187,6 +554,8 @@ public:
 
 	//subdivides this point, maintains this edges root
 	void subdivide(_P mid_point) {
+		invalidateGeometry();
+
 		Edge<_P>* adjoint = universe->createEdge();
 		Point<_P>* mid = universe->createPoint();
 
@@ -258,6 +627,8 @@ public:
 	//just moves root if it is isolated
 	//returns the face left at og root if it exists
 	EdgeModResult<_P> moveRoot(_P p) {
+		invalidateGeometry();
+
 		Point<_P>* og = root;
 		if (last == inv) {
 			//root is isolated
@@ -306,6 +677,7 @@ public:
 	//returns the face left at og root if it exists
 	EdgeModResult<_P> insertAfter(Edge<_P>* target) {
 		//remove from og
+		invalidateGeometry();
 
 		Face<_P>* novel_a = nullptr;
 		Face<_P>* novel_b = nullptr;
@@ -346,6 +718,8 @@ public:
 		target->next = this;
 		last = target;
 
+		target->loop->geometry_valid = false;
+
 		if (target->loop == loop) {
 			//we have split a loop
 			loop->root = this;
@@ -384,6 +758,8 @@ public:
 		Face<_P>* novel = nullptr;
 		EdgeModResult<_P> product(EdgeModType::faces_preserved, nullptr);
 
+		invalidateGeometry();
+
 		if (next == inv) {
 			loose_strand = true;
 
@@ -438,6 +814,10 @@ public:
 			}
 		}
 		else if (isolated) {
+			//the edge pair was the whole loop, the face goes with it
+			//callers drop a face reported as destroyed, so leaving it in the pool would keep a face whose root is the freed edge
+			universe->removeFace(loop);
+
 			product.type = EdgeModType::face_destroyed;
 			product.relevant = loop;
 		}
@@ -448,10 +828,12 @@ public:
 
 	//contracts this edge, the resulting point position is this edges root position
 	void contract() {
+		invalidateGeometry();
 
 		Edge<_P>* focus = next;
 
 		do {
+			focus->invalidateGeometry();
 			focus->root = root;
 			focus = focus->inv->next;
 		} while (focus != inv);
@@ -495,12 +877,14 @@ class Face {
 		universe = uni;
 		group = nullptr;
 
-		mark = 0;
+		visit_stamp = 0;
+		geometry_valid = false;
 	}
 	Face(DCEL<_P> * uni, Region<_P> * grp) {
 		universe = uni;
 
-		mark = 0;
+		visit_stamp = 0;
+		geometry_valid = false;
 	}
 	Face(Face<_P> &&) = delete;
 	Face(Face<_P> const &) = delete;
@@ -518,10 +902,73 @@ class Face {
 			focus->loop = this;
 			focus = focus->next;
 		} while (focus != root);
+
+		geometry_valid = false;
+	}
+
+	// visitation stamp, see DCEL::beginTraversal
+	mutable unsigned visit_stamp;
+
+	Epoch_Mark mark;
+
+	//cached geometry, refreshed on request after any mutation of the loop
+	mutable typename Geometry_Traits<_P>::scalar area_cache;
+	mutable _P box_min;
+	mutable _P box_max;
+	mutable int size_cache;
+	mutable bool geometry_valid;
+
+	void refreshGeometry() const {
+		if (geometry_valid)
+			return;
+
+		Edge<_P> const * focus = root;
+
+		box_min = root->root->getPosition();
+		box_max = box_min;
+		size_cache = 0;
+
+		do {
+			_P const & position = focus->root->getPosition();
+
+			if (position.X < box_min.X)
+				box_min.X = position.X;
+			if (position.Y < box_min.Y)
+				box_min.Y = position.Y;
+			if (position.X > box_max.X)
+				box_max.X = position.X;
+			if (position.Y > box_max.Y)
+				box_max.Y = position.Y;
+
+			size_cache++;
+
+			focus = focus->next;
+		} while (focus != root);
+
+		area_cache = _P::area(loopPoints());
+
+		geometry_valid = true;
 	}
 
 public:
-	int mark;
+	int getMark() const {
+		return mark.get(universe->face_mark_epoch);
+	}
+	void setMark(int value) {
+		mark.set(value, universe->face_mark_epoch);
+	}
+
+	//test-and-set, returns true only the first time this is visited within the traversal epoch
+	bool visit(unsigned epoch) const {
+		if (visit_stamp == epoch)
+			return false;
+
+		visit_stamp = epoch;
+		return true;
+	}
+	bool visited(unsigned epoch) const {
+		return visit_stamp == epoch;
+	}
 
 	//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 	//         Traversal Methods
@@ -547,26 +994,51 @@ public:
 
 	//get the count of edges in the boundary
 	int getLoopSize() const {
-		Edge<_P> const * focus = root;
-		int count = 0;
+		refreshGeometry();
+		return size_cache;
+	}
 
-		do {
-			count++;
+	//the signed area enclosed by the loop
+	typename Geometry_Traits<_P>::scalar const & getArea() const {
+		refreshGeometry();
+		return area_cache;
+	}
+	//the sign of the enclosed area, -1, 0, or 1
+	int getOrientation() const {
+		refreshGeometry();
+		return area_cache < 0 ? -1 : (area_cache > 0 ? 1 : 0);
+	}
+	//the corners of the axis aligned bounding box of the loop
+	_P const & getBoxMin() const {
+		refreshGeometry();
+		return box_min;
+	}
+	_P const & getBoxMax() const {
+		refreshGeometry();
+		return box_max;
+	}
 
-			focus = focus->next;
-		} while (focus != root);
+	//the edges in the loop, walked in place
+	Cycle_Range<Edge<_P>, Loop_Step> loopEdges() {
+		return Cycle_Range<Edge<_P>, Loop_Step>(root);
+	}
+
+	Cycle_Range<Edge<_P> const, Loop_Step> loopEdges() const {
+		return Cycle_Range<Edge<_P> const, Loop_Step>(root);
+	}
 
-		return count;
+	//the points in the loop, walked in place
+	Loop_Point_Range<_P> loopPoints() const {
+		return Loop_Point_Range<_P>(root);
 	}
 
 	//return a list of the points in the loop
-	FLL<_P> getLoopPoints() const {
-		FLL<_P> target;
+	SVL<_P> getLoopPoints() const {
+		SVL<_P> target;
 		Edge<_P> const * focus = root;
 
 		do {
-			_P p = focus->root->getPosition();
-			target.append(p);
+			target.append(focus->root->getPosition());
 
 			focus = focus->next;
 		} while (focus != root);
@@ -575,35 +1047,25 @@ public:
 	}
 
 	//return a list of the edges in the loop
-	FLL<Edge<_P> *> getLoopEdges() {
-		Edge<_P> * focus = root;
-		FLL<Edge<_P> *> target;
+	SVL<Edge<_P> *> getLoopEdges() {
+		SVL<Edge<_P> *> target;
 
-		do {
-			target.append(focus);
-
-			focus = focus->next;
-		} while (focus != root);
+		getLoopEdges(target);
 
 		return target;
 	}
 
 	//returns a list of the edges in the loop
-	FLL<Edge<_P> const *> getLoopEdges() const {
-		Edge<_P> * focus = root;
-		FLL<Edge<_P> *> target;
+	SVL<Edge<_P> const *> getLoopEdges() const {
+		SVL<Edge<_P> const *> target;
 
-		do {
-			target.append(focus);
-
-			focus = focus->next;
-		} while (focus != root);
+		getLoopEdges(target);
 
 		return target;
 	}
 
 	//write to a list, the edges in the loop
-	void getLoopEdges(FLL<Edge<_P> *> &target) {
+	void getLoopEdges(SVL<Edge<_P> *> &target) {
 		Edge<_P> * focus = root;
 		do {
 			target.append(focus);
@@ -613,8 +1075,8 @@ public:
 	}
 
 	//write to a list, the edges in the loop
-	void getLoopEdges(FLL<Edge<_P> const *> &target) const {
-		Edge<_P> * focus = root;
+	void getLoopEdges(SVL<Edge<_P> const *> &target) const {
+		Edge<_P> const * focus = root;
 		do {
 			target.append(focus);
 
@@ -623,13 +1085,14 @@ public:
 	}
 
 	//return a list of the faces that share a boundary in the loop
-	FLL<Face<_P> *> getNeighbors() {
-		FLL<Face<_P> *> target;
+	SVL<Face<_P> *> getNeighbors() {
+		SVL<Face<_P> *> target;
 		Edge<_P> * focus = root;
+		unsigned const epoch = universe->beginTraversal();
 
 		do {
 			Face<_P> * canidate = focus->inv->loop;
-			if (!target.contains(canidate)) {
+			if (canidate->visit(epoch)) {
 				target.append(canidate);
 			}
 			focus = focus->next;
@@ -639,13 +1102,14 @@ public:
 	}
 
 	//return a list of the faces that share a boundary in the loop
-	FLL<Face<_P> const *> getNeighbors() const {
-		FLL<Face<_P> const *> target;
+	SVL<Face<_P> const *> getNeighbors() const {
+		SVL<Face<_P> const *> target;
 		Edge<_P> const * focus = root;
+		unsigned const epoch = universe->beginTraversal();
 
 		do {
 			Face<_P> const * canidate = focus->inv->loop;
-			if (!target.contains(canidate)) {
+			if (canidate->visit(epoch)) {
 				target.append(canidate);
 			}
 			focus = focus->next;
@@ -713,13 +1177,17 @@ public:
 	FLL<Face<_P> *> mergeWithFace(Face<_P>* target) {
 		FLL<Edge<_P> *> markToRemove;
 		FLL<Face<_P> *> product;
+		unsigned const epoch = universe->beginTraversal();
 
 		Edge<_P> * focus = root;
 		do {
 
+			//only one of each edge pair is removed
 			if (focus->inv->loop == target)
-				if(!markToRemove.contains(focus->inv))
+				if (!focus->inv->visited(epoch)) {
+					focus->visit(epoch);
 					markToRemove.append(focus);
+				}
 
 			focus = focus->next;
 		} while (focus != root);
@@ -748,22 +1216,51 @@ class Region {
 	Region(DCEL<_P> * uni) {
 		universe = uni;
 
-		mark = 0;
+		visit_stamp = 0;
 	}
 	~Region() {
 
 	}
-	FLL<Face<_P> *> Boundaries;
+	SVL<Face<_P> *> Boundaries;
 
 	Region(Region<_P> &&) = delete;
 	Region(Region<_P> const &) = delete;
 
+	// visitation stamp, see DCEL::beginTraversal
+	mutable unsigned visit_stamp;
+
+	Epoch_Mark mark;
+
 public:
-	int mark;
+	int getMark() const {
+		return mark.get(universe->region_mark_epoch);
+	}
+	void setMark(int value) {
+		mark.set(value, universe->region_mark_epoch);
+	}
+
+	//test-and-set, returns true only the first time this is visited within the traversal epoch
+	bool visit(unsigned epoch) const {
+		if (visit_stamp == epoch)
+			return false;
 
-	FLL<Face<_P> *> const & getBounds() {
+		visit_stamp = epoch;
+		return true;
+	}
+	bool visited(unsigned epoch) const {
+		return visit_stamp == epoch;
+	}
+
+	SVL<Face<_P> *> const & getBounds() {
 		return Boundaries;
 	}
+	//the edges of every boundary, walked in place
+	Boundary_Edge_Range<_P, Edge<_P>> boundaryEdges() {
+		return Boundary_Edge_Range<_P, Edge<_P>>(Boundaries.data(), Boundaries.data() + Boundaries.size());
+	}
+	Boundary_Edge_Range<_P, Edge<_P> const> boundaryEdges() const {
+		return Boundary_Edge_Range<_P, Edge<_P> const>(Boundaries.data(), Boundaries.data() + Boundaries.size());
+	}
 	Face<_P> * operator[](int a) {
 		return Boundaries[a];
 	}
@@ -800,19 +1297,31 @@ public:
 		return universe;
 	}
 
-	FLL<Region *> getNeighbors() {
-		FLL<Region *> product;
+	//the most recently found neighbor comes first
+	//faces without a group are reported as a single nullptr neighbor
+	SVL<Region *> getNeighbors() {
+		SVL<Region *> product;
+		bool found_ungrouped = false;
+		unsigned const epoch = universe->beginTraversal();
 
 		for (auto border : Boundaries) {
 			auto canidates = border->getNeighbors();
 			for (auto suggest : canidates) {
-				if (!product.contains(suggest->group)) {
-					product.push(suggest->group);
+				Region * group = suggest->group;
+
+				if (group == nullptr) {
+					if (!found_ungrouped) {
+						found_ungrouped = true;
+						product.append(group);
+					}
+				}
+				else if (group->visit(epoch)) {
+					product.append(group);
 				}
 			}
 		}
 
-		return product;
+		return product.reverse();
 	}
 
 };
@@ -821,28 +1330,55 @@ public:
 
 template <class _P>
 class DCEL {
-	FLL<Point<_P> *> points;
-	FLL<Edge<_P> *> edges;
-	FLL<Face<_P> *> faces;
-	FLL<Region<_P> *> regions;
+	Pool<Point<_P>> points;
+	Pool<Edge<_P>> edges;
+	Pool<Face<_P>> faces;
+	Pool<Region<_P>> regions;
+
+	//marks of each kind only read as set within their current epoch
+	unsigned point_mark_epoch;
+	unsigned edge_mark_epoch;
+	unsigned face_mark_epoch;
+	unsigned region_mark_epoch;
 
+	//the most recent traversal epoch
+	unsigned visit_epoch;
+
+	friend Point<_P>;
 	friend Edge<_P>;
+	friend Face<_P>;
+	friend Region<_P>;
+	friend Baked_DCEL<_P>;
+
+	//advances a mark epoch, clearing stored marks of that kind only when the counter wraps
+	template <class _E>
+	static void advanceMarkEpoch(unsigned & epoch, Pool<_E> & pool) {
+		epoch++;
+
+		if (epoch == 0) {
+			for (auto element : pool)
+				element->mark = Epoch_Mark();
+
+			epoch = 1;
+		}
+	}
+
+	template <class _E>
+	static void clearVisits(Pool<_E> & pool) {
+		for (auto element : pool)
+			element->visit_stamp = 0;
+	}
 
 	//creates a point
 	//no parameters are initialized
 	Point<_P> * createPoint() {
-		Point<_P> * result = new Point<_P>(this);
-		points.push(result);
-		return result;
+		return new (points.acquire()) Point<_P>(this);
 	}
 	//creates an edge and its inverse
 	//no parameters are initialized
 	Edge<_P> * createEdge() {
-		Edge<_P> * result = new Edge<_P>(this);
-		Edge<_P> * inverse = new Edge<_P>(this);
-
-		edges.push(result);
-		edges.push(inverse);
+		Edge<_P> * result = new (edges.acquire()) Edge<_P>(this);
+		Edge<_P> * inverse = new (edges.acquire()) Edge<_P>(this);
 
 		result->inv = inverse;
 		inverse->inv = result;
@@ -852,52 +1388,56 @@ class DCEL {
 	//creates a face
 	//no parameters are initialized
 	Face<_P> * createFace() {
-		Face<_P> * result = new Face<_P>(this);
-		faces.push(result);
-		return result;
+		return new (faces.acquire()) Face<_P>(this);
 	}
 
 	//removes a point
 	//does NOT check to see if referenced elsewhere
 	void removePoint(Point<_P> * target) {
-		points.remove(target);
-
-		delete target;
+		target->~Point();
+		points.release(target);
 	}
 	//removes an edge and its inverse
 	//does NOT check to see if referenced elsewhere
 	void removeEdge(Edge<_P> * target) {
-		edges.remove(target);
-		edges.remove(target->inv);
+		Edge<_P> * inverse = target->inv;
+
+		inverse->~Edge();
+		edges.release(inverse);
 
-		delete target->inv;
-		delete target;
+		target->~Edge();
+		edges.release(target);
 	}
 	//removes a face
 	//does NOT check to see if referenced elsewhere
 	void removeFace(Face<_P> * target) {
-		faces.remove(target);
-
-		delete target;
+		target->~Face();
+		faces.release(target);
 	}
 
 public:
+	DCEL() {
+		point_mark_epoch = 1;
+		edge_mark_epoch = 1;
+		face_mark_epoch = 1;
+		region_mark_epoch = 1;
+
+		visit_epoch = 0;
+	}
+
+	//elements are destroyed in place, the pools then release whole slabs
 	~DCEL() {
-		for(auto focus_point : points) {
-			delete focus_point;
-		}
+		for (auto focus_point : points)
+			focus_point->~Point();
 
-		for (auto focus_edge : edges) {
-			delete focus_edge;
-		}
+		for (auto focus_edge : edges)
+			focus_edge->~Edge();
 
-		for (auto focus_face : faces) {
-			delete focus_face;
-		}
+		for (auto focus_face : faces)
+			focus_face->~Face();
 
-		for (auto focus_region : regions) {
-			delete focus_region;
-		}
+		for (auto focus_region : regions)
+			focus_region->~Region();
 	}
 
 	int pointCount() const {
@@ -913,6 +1453,53 @@ public:
 		return regions.size();
 	}
 
+	//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+	//         Handles
+
+	//handles are stable for the lifetime of an element, and may be reused after it is removed
+
+	unsigned getHandle(Point<_P> const * target) const {
+		return points.handleOf(target);
+	}
+	unsigned getHandle(Edge<_P> const * target) const {
+		return edges.handleOf(target);
+	}
+	unsigned getHandle(Face<_P> const * target) const {
+		return faces.handleOf(target);
+	}
+	unsigned getHandle(Region<_P> const * target) const {
+		return regions.handleOf(target);
+	}
+
+	//a handle names the same element only while its generation is unchanged
+
+	unsigned getGeneration(Point<_P> const * target) const {
+		return points.generationOf(target);
+	}
+	unsigned getGeneration(Edge<_P> const * target) const {
+		return edges.generationOf(target);
+	}
+	unsigned getGeneration(Face<_P> const * target) const {
+		return faces.generationOf(target);
+	}
+	unsigned getGeneration(Region<_P> const * target) const {
+		return regions.generationOf(target);
+	}
+
+	//returns nullptr if the handle does not reference a live element
+	Point<_P> * getPoint(unsigned handle) {
+		return points.fromHandle(handle);
+	}
+	Edge<_P> * getEdge(unsigned handle) {
+		return edges.fromHandle(handle);
+	}
+	Face<_P> * getFace(unsigned handle) {
+		return faces.fromHandle(handle);
+	}
+	Region<_P> * getRegion(unsigned handle) {
+		return regions.fromHandle(handle);
+	}
+
 	//creates an edge and its inverse connecting two novel points
 	Edge<_P> * addEdge(_P a, _P b) {
 		Edge<_P> * result = createEdge();
@@ -963,6 +1550,8 @@ public:
 		result->loop = a->loop;
 		result->inv->loop = a->loop;
 
+		a->loop->geometry_valid = false;
+
 		return result;
 	}
 	//creates an edge and its inverse connecting after an two edges
@@ -1003,25 +1592,23 @@ public:
 			a->loop->reFace();
 		}
 
+		a->loop->geometry_valid = false;
+
 		return result;
 	}
 
 	Region<_P> * region() {
-		Region<_P> * product = new Region<_P>(this);
-		regions.append(product);
-		return product;
+		return new (regions.acquire()) Region<_P>(this);
 	}
 
 	Region<_P> * region(Face<_P> * face) {
-		Region<_P> * product = new Region<_P>(this);
+		Region<_P> * product = region();
 		product->append(face);
-		regions.append(product);
 		return product;
 	}
 	Region<_P> * region(FLL<_P> const &boundary) {
-		Region<_P> * product = new Region<_P>(this);
+		Region<_P> * product = region();
 		product->append(draw(boundary));
-		regions.append(product);
 		return product;
 	}
 
@@ -1055,28 +1642,55 @@ public:
 	//removes a region
 	//does NOT check to see if referenced elsewhere
 	void removeRegion(Region<_P> * target) {
-		regions.remove(target);
-
-		delete target;
+		target->~Region();
+		regions.release(target);
 	}
 
+	//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+	//         Marking
+
+	//resets are O(1), all marks of the kind read as zero afterwards
+
 	void resetPointMarks() {
-		for (auto point : points)
-			point->mark = 0;
+		advanceMarkEpoch(point_mark_epoch, points);
 	}
 
 	void resetEdgeMarks() {
-		for (auto edge : edges)
-			edge->mark = 0;
+		advanceMarkEpoch(edge_mark_epoch, edges);
 	}
 
 	void resetFaceMarks() {
-		for (auto face : faces)
-			face->mark = 0;
+		advanceMarkEpoch(face_mark_epoch, faces);
 	}
 
 	void resetRegionMarks() {
-		for (auto region : regions)
-			region->mark = 0;
+		advanceMarkEpoch(region_mark_epoch, regions);
+	}
+
+	//begins a traversal, every element is unvisited within the returned epoch
+	//traversals over the same kind of element must not be nested
+	unsigned beginTraversal() {
+		visit_epoch++;
+
+		if (visit_epoch == 0) {
+			clearVisits(points);
+			clearVisits(edges);
+			clearVisits(faces);
+			clearVisits(regions);
+
+			visit_epoch = 1;
+		}
+
+		return visit_epoch;
+	}
+
+	//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+	//         Baking
+
+	//returns a compact read only snapshot of the current structure, see Baked_DCEL.h
+	Baked_DCEL<_P> bake() const {
+		return Baked_DCEL<_P>(*this);
 	}
 };
+
+#include "Baked_DCEL.h"
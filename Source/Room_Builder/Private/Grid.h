@@ -1,53 +1,141 @@
 #pragma once
+#include "Grid_Kernel.h"
 
-#define grid_epsilon .000001
+//the tolerance of the selected kernel, also used for geometric tests built on grd
+#define grid_epsilon (grid_kernel::tolerance())
 
-class grd {
-	
+//a coordinate with tolerant comparisons, stored and compared as the kernel defines
+//trivially copyable and defined inline, so coordinates stay in registers across translation units
+template <class _K>
+class basic_grd {
+	typedef typename _K::storage storage;
+
+	static constexpr basic_grd raw(storage value) {
+		return basic_grd(value, 0);
+	}
+	constexpr basic_grd(storage value, int) : n(value) {}
 
 public:
-	double n;
+	storage n;
 
-	grd();
-	grd(double num);
+	constexpr basic_grd() : n(0) {}
+	constexpr basic_grd(double num) : n(_K::fromDouble(num)) {}
 
-	grd(grd &&target);
-	grd(grd const &target);
+	basic_grd(basic_grd &&target) = default;
+	basic_grd(basic_grd const &target) = default;
 
-	grd & operator=(double const & target);
-	grd & operator=(grd const & target);
+	basic_grd & operator=(basic_grd &&target) = default;
+	basic_grd & operator=(basic_grd const & target) = default;
+	basic_grd & operator=(double const & target) {
+		n = _K::fromDouble(target);
+		return *this;
+	}
 	
-	grd operator-() const;
-	grd operator+(double factor) const;
-	grd operator+(const grd &add) const;
-	grd operator-(double factor) const;
-	grd operator-(const grd &sub) const;
-	grd operator*(double factor) const;
-	grd operator*(const grd &target) const;
-	grd operator/(double factor) const;
-	grd operator/(const grd &target) const;
-
-	grd& operator+=(double factor);
-	grd& operator+=(const grd &target);
-	grd& operator-=(double factor);
-	grd& operator-=(const grd &target);
-	grd& operator*=(double factor);
-	grd& operator*=(const grd &target);
-	grd& operator/=(double factor);
-	grd& operator/=(const grd &target);
-
-	bool operator==(const double &test) const;
-	bool operator==(const grd &test) const;
-	bool operator!=(const double &test) const;
-	bool operator!=(const grd &test) const;
-	bool operator>(const double &test) const;
-	bool operator>(const grd &test) const;
-	bool operator<(const double &test) const;
-	bool operator<(const grd &test) const;
-	bool operator>=(const double &test) const;
-	bool operator>=(const grd &test) const;
-	bool operator<=(const double &test) const;
-	bool operator<=(const grd &test) const;
-
-	grd sqrt() const;
-};
\ No newline at end of file
+	constexpr basic_grd operator-() const {
+		return raw(_K::negate(n));
+	}
+	constexpr basic_grd operator+(double factor) const {
+		return raw(_K::add(n, _K::fromDouble(factor)));
+	}
+	constexpr basic_grd operator+(const basic_grd &add) const {
+		return raw(_K::add(n, add.n));
+	}
+	constexpr basic_grd operator-(double factor) const {
+		return raw(_K::subtract(n, _K::fromDouble(factor)));
+	}
+	constexpr basic_grd operator-(const basic_grd &sub) const {
+		return raw(_K::subtract(n, sub.n));
+	}
+	constexpr basic_grd operator*(double factor) const {
+		return raw(_K::scale(n, factor));
+	}
+	constexpr basic_grd operator*(const basic_grd &target) const {
+		return raw(_K::multiply(n, target.n));
+	}
+	constexpr basic_grd operator/(double factor) const {
+		return raw(_K::shrink(n, factor));
+	}
+	constexpr basic_grd operator/(const basic_grd &target) const {
+		return raw(_K::divide(n, target.n));
+	}
+
+	basic_grd& operator+=(double factor) {
+		n = _K::add(n, _K::fromDouble(factor));
+		return *this;
+	}
+	basic_grd& operator+=(const basic_grd &target) {
+		n = _K::add(n, target.n);
+		return *this;
+	}
+	basic_grd& operator-=(double factor) {
+		n = _K::subtract(n, _K::fromDouble(factor));
+		return *this;
+	}
+	basic_grd& operator-=(const basic_grd &target) {
+		n = _K::subtract(n, target.n);
+		return *this;
+	}
+	basic_grd& operator*=(double factor) {
+		n = _K::scale(n, factor);
+		return *this;
+	}
+	basic_grd& operator*=(const basic_grd &target) {
+		n = _K::multiply(n, target.n);
+		return *this;
+	}
+	basic_grd& operator/=(double factor) {
+		n = _K::shrink(n, factor);
+		return *this;
+	}
+	basic_grd& operator/=(const basic_grd &target) {
+		n = _K::divide(n, target.n);
+		return *this;
+	}
+
+	constexpr bool operator==(const double &test) const {
+		return _K::equal(n, _K::fromDouble(test));
+	}
+	constexpr bool operator==(const basic_grd &test) const {
+		return _K::equal(n, test.n);
+	}
+	constexpr bool operator!=(const double &test) const {
+		return _K::notEqual(n, _K::fromDouble(test));
+	}
+	constexpr bool operator!=(const basic_grd &test) const {
+		return _K::notEqual(n, test.n);
+	}
+	constexpr bool operator>(const double &test) const {
+		return _K::greater(n, _K::fromDouble(test));
+	}
+	constexpr bool operator>(const basic_grd &test) const {
+		return _K::greater(n, test.n);
+	}
+	constexpr bool operator<(const double &test) const {
+		return _K::less(n, _K::fromDouble(test));
+	}
+	constexpr bool operator<(const basic_grd &test) const {
+		return _K::less(n, test.n);
+	}
+	constexpr bool operator>=(const double &test) const {
+		return _K::greaterEqual(n, _K::fromDouble(test));
+	}
+	constexpr bool operator>=(const basic_grd &test) const {
+		return _K::greaterEqual(n, test.n);
+	}
+	constexpr bool operator<=(const double &test) const {
+		return _K::lessEqual(n, _K::fromDouble(test));
+	}
+	constexpr bool operator<=(const basic_grd &test) const {
+		return _K::lessEqual(n, test.n);
+	}
+
+	basic_grd sqrt() const {
+		return raw(_K::sqrt(n));
+	}
+
+	constexpr double value() const {
+		return _K::toDouble(n);
+	}
+};
+
+typedef basic_grd<grid_kernel> grd;
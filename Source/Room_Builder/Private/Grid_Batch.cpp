@@ -0,0 +1,437 @@
+#include "Grid_Batch.h"
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+	//         Lanes
+
+	//a block of doubles, comparisons yield masks of the same width
+
+#if defined(__AVX__)
+
+	struct lanes {
+		static int const width = 4;
+		__m256d v;
+
+		static lanes load(double const * source) { return { _mm256_loadu_pd(source) }; }
+		void store(double * target) const { _mm256_storeu_pd(target, v); }
+		static lanes set(double a) { return { _mm256_set1_pd(a) }; }
+		static lanes none() { return { _mm256_setzero_pd() }; }
+		static lanes all() { return { _mm256_castsi256_pd(_mm256_set1_epi64x(-1)) }; }
+
+		friend lanes operator+(lanes a, lanes b) { return { _mm256_add_pd(a.v, b.v) }; }
+		friend lanes operator-(lanes a, lanes b) { return { _mm256_sub_pd(a.v, b.v) }; }
+		friend lanes operator*(lanes a, lanes b) { return { _mm256_mul_pd(a.v, b.v) }; }
+		friend lanes operator/(lanes a, lanes b) { return { _mm256_div_pd(a.v, b.v) }; }
+		friend lanes max(lanes a, lanes b) { return { _mm256_max_pd(a.v, b.v) }; }
+
+		friend lanes operator>(lanes a, lanes b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ) }; }
+		friend lanes operator<(lanes a, lanes b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ) }; }
+
+		friend lanes operator&(lanes a, lanes b) { return { _mm256_and_pd(a.v, b.v) }; }
+		friend lanes operator|(lanes a, lanes b) { return { _mm256_or_pd(a.v, b.v) }; }
+		friend lanes operator^(lanes a, lanes b) { return { _mm256_xor_pd(a.v, b.v) }; }
+
+		friend lanes operator~(lanes a) { return a ^ all(); }
+
+		int mask() const { return _mm256_movemask_pd(v); }
+	};
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+	struct lanes {
+		static int const width = 2;
+		__m128d v;
+
+		static lanes load(double const * source) { return { _mm_loadu_pd(source) }; }
+		void store(double * target) const { _mm_storeu_pd(target, v); }
+		static lanes set(double a) { return { _mm_set1_pd(a) }; }
+		static lanes none() { return { _mm_setzero_pd() }; }
+		static lanes all() { return { _mm_castsi128_pd(_mm_set1_epi32(-1)) }; }
+
+		friend lanes operator+(lanes a, lanes b) { return { _mm_add_pd(a.v, b.v) }; }
+		friend lanes operator-(lanes a, lanes b) { return { _mm_sub_pd(a.v, b.v) }; }
+		friend lanes operator*(lanes a, lanes b) { return { _mm_mul_pd(a.v, b.v) }; }
+		friend lanes operator/(lanes a, lanes b) { return { _mm_div_pd(a.v, b.v) }; }
+		friend lanes max(lanes a, lanes b) { return { _mm_max_pd(a.v, b.v) }; }
+
+		friend lanes operator>(lanes a, lanes b) { return { _mm_cmpgt_pd(a.v, b.v) }; }
+		friend lanes operator<(lanes a, lanes b) { return { _mm_cmplt_pd(a.v, b.v) }; }
+
+		friend lanes operator&(lanes a, lanes b) { return { _mm_and_pd(a.v, b.v) }; }
+		friend lanes operator|(lanes a, lanes b) { return { _mm_or_pd(a.v, b.v) }; }
+		friend lanes operator^(lanes a, lanes b) { return { _mm_xor_pd(a.v, b.v) }; }
+
+		friend lanes operator~(lanes a) { return a ^ all(); }
+
+		int mask() const { return _mm_movemask_pd(v); }
+	};
+
+#else
+
+	//one lane, masks are 0 or 1
+	struct lanes {
+		static int const width = 1;
+		double v;
+
+		static lanes load(double const * source) { return { *source }; }
+		void store(double * target) const { *target = v; }
+		static lanes set(double a) { return { a }; }
+		static lanes none() { return { 0 }; }
+		static lanes all() { return { 1 }; }
+
+		friend lanes operator+(lanes a, lanes b) { return { a.v + b.v }; }
+		friend lanes operator-(lanes a, lanes b) { return { a.v - b.v }; }
+		friend lanes operator*(lanes a, lanes b) { return { a.v * b.v }; }
+		friend lanes operator/(lanes a, lanes b) { return { a.v / b.v }; }
+		friend lanes max(lanes a, lanes b) { return { a.v > b.v ? a.v : b.v }; }
+
+		friend lanes operator>(lanes a, lanes b) { return { a.v > b.v ? 1.0 : 0.0 }; }
+		friend lanes operator<(lanes a, lanes b) { return { a.v < b.v ? 1.0 : 0.0 }; }
+
+		friend lanes operator&(lanes a, lanes b) { return { (a.v != 0 && b.v != 0) ? 1.0 : 0.0 }; }
+		friend lanes operator|(lanes a, lanes b) { return { (a.v != 0 || b.v != 0) ? 1.0 : 0.0 }; }
+		friend lanes operator^(lanes a, lanes b) { return { ((a.v != 0) != (b.v != 0)) ? 1.0 : 0.0 }; }
+
+		friend lanes operator~(lanes a) { return a ^ all(); }
+
+		int mask() const { return v != 0 ? 1 : 0; }
+	};
+
+#endif
+
+	//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+	//         Loops
+
+	//a closed loop as struct of arrays, with the per edge constants of the crossing test worked out once
+	//sloped edges are stored running upward, from low to low + (run, length)
+	//near horizontal edges can only be touched, only the band of heights they cover is kept
+	struct loop_lanes {
+		SVL<double, 32> low_x;
+		SVL<double, 32> low_y;
+		SVL<double, 32> run;
+		SVL<double, 32> length;
+
+		SVL<double, 32> flat_bottom;
+		SVL<double, 32> flat_top;
+
+		template <class _L>
+		explicit loop_lanes(_L const & loop) {
+			double const epsilon = grid_epsilon;
+
+			auto const end = loop.end();
+			if (loop.begin() == end)
+				return;
+
+			Pgrd last;
+			for (auto focus = loop.begin(); focus != end; ++focus)
+				last = *focus;
+
+			for (auto focus = loop.begin(); focus != end; ++focus) {
+				Pgrd const & next = *focus;
+
+				double const sx = last.X.value();
+				double const sy = last.Y.value();
+				double const dx = (next.X - last.X).value();
+				double const dy = (next.Y - last.Y).value();
+
+				if (dy < 2 * epsilon && dy > -2 * epsilon) {
+					flat_bottom.append(std::fmin(sy, sy + dy) - 4 * epsilon);
+					flat_top.append(std::fmax(sy, sy + dy) + 4 * epsilon);
+				}
+				else if (dy > 0) {
+					low_x.append(sx);
+					low_y.append(sy);
+					run.append(dx);
+					length.append(dy);
+				}
+				else {
+					low_x.append(sx + dx);
+					low_y.append(sy + dy);
+					run.append(-dx);
+					length.append(-dy);
+				}
+
+				last = next;
+			}
+		}
+	};
+
+	//pads the coordinates to whole blocks, the padding is never read back
+	void pad(SVL<double, 32> & x, SVL<double, 32> & y) {
+		while (x.size() % lanes::width != 0) {
+			x.append(0);
+			y.append(0);
+		}
+	}
+
+	//the crossing parity of each point against the loop, along with whether it is decided
+	//a point is undecided when it lies within tolerance of an edge, or level with a vertex within tolerance,
+	//the only places the scalar test's tolerances come into play
+	//bounds are 2 epsilon, twice the scalar tolerance, and cover the rounding of either evaluation
+	//x and y must be padded, count is the number of points to report
+	void crossings(loop_lanes const & loop, SVL<double, 32> const & x, SVL<double, 32> const & y, int count,
+		SVL<unsigned char, 32> & crossed, SVL<unsigned char, 32> & undecided) {
+
+		double const epsilon = grid_epsilon;
+		int const full_mask = (1 << lanes::width) - 1;
+
+		for (int block = 0; block < count; block += lanes::width) {
+			lanes const point_x = lanes::load(x.data() + block);
+			lanes const point_y = lanes::load(y.data() + block);
+
+			lanes parity = lanes::none();
+			lanes unsure = lanes::none();
+
+			//decided when the point is clearly above or below
+			for (int edge = 0; edge < loop.flat_top.size(); edge++)
+				unsure = unsure | ~((point_y < lanes::set(loop.flat_bottom[edge])) | (point_y > lanes::set(loop.flat_top[edge])));
+
+			for (int edge = 0; edge < loop.length.size(); edge++) {
+				double const length = loop.length[edge];
+				double const band = 2 * epsilon * length;
+
+				lanes const s = point_y - lanes::set(loop.low_y[edge]);
+				lanes const beyond = (s < lanes::set(-band)) | (s > lanes::set(length + band));
+
+				//most edges lie clear of the whole block's heights, and neither cross nor touch any of it
+				if (beyond.mask() == full_mask)
+					continue;
+
+				lanes const along = (s > lanes::set(band)) & (s < lanes::set(length - band));
+
+				//horizontal distance to the edge, scaled by its length, positive to the right
+				lanes const distance = (point_x - lanes::set(loop.low_x[edge])) * lanes::set(length) -
+					lanes::set(loop.run[edge]) * s;
+
+				lanes const right = distance > lanes::set(band);
+				lanes const left = distance < lanes::set(-band);
+
+				parity = parity ^ (along & right);
+				unsure = unsure | ~(beyond | (along & (right | left)));
+			}
+
+			int const parity_mask = parity.mask();
+			int const unsure_mask = unsure.mask();
+
+			for (int lane = 0; lane < lanes::width && block + lane < count; lane++) {
+				crossed.append((parity_mask >> lane) & 1);
+				undecided.append((unsure_mask >> lane) & 1);
+			}
+		}
+	}
+
+	//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+	//         Segments
+
+	//a list of segments as struct of arrays, segment i runs from start to start + delta
+	//padded to whole blocks with empty segments, which are never read back
+	struct segment_lanes {
+		SVL<double, 32> start_x;
+		SVL<double, 32> start_y;
+		SVL<double, 32> delta_x;
+		SVL<double, 32> delta_y;
+
+		explicit segment_lanes(SVL<Edge<Pgrd> *> const & edges) {
+			for (auto edge : edges) {
+				Pgrd const & start = edge->getStart()->getPosition();
+				Pgrd const & end = edge->getEnd()->getPosition();
+
+				start_x.append(start.X.value());
+				start_y.append(start.Y.value());
+				delta_x.append((end.X - start.X).value());
+				delta_y.append((end.Y - start.Y).value());
+			}
+
+			while (start_x.size() % lanes::width != 0) {
+				start_x.append(0);
+				start_y.append(0);
+				delta_x.append(0);
+				delta_y.append(0);
+			}
+		}
+	};
+
+	//the orientation of a triangle, decided only when its height clears twice the tolerance of orientation
+	//at that distance the sign of the double determinant is exact, so decided sides always match orientation
+	struct lane_side {
+		lanes left;
+		lanes right;
+
+		lane_side(lanes det, lanes longest_squared, lanes bound) {
+			lanes const clear = det * det > bound * longest_squared;
+			left = clear & (det > lanes::none());
+			right = clear & (det < lanes::none());
+		}
+	};
+
+	lanes squared(lanes x, lanes y) {
+		return x * x + y * y;
+	}
+}
+
+void getPointRelations(Face<Pgrd> & rel, SVL<Pgrd> const & points, SVL<FaceRelation> & results) {
+	bool const inverted = rel.getArea() < 0;
+
+	//points outside the bounds take the default, as they do in getPointRelation
+	//the bounds test is inBounds, with the box and margin read once
+	Pgrd const & box_min = rel.getBoxMin();
+	Pgrd const & box_max = rel.getBoxMax();
+
+	double const extent = std::fmax(box_max.X.value() - box_min.X.value(), box_max.Y.value() - box_min.Y.value());
+	double const margin = 2 * grid_epsilon * (extent + 1);
+
+	double const min_x = box_min.X.value() - margin;
+	double const min_y = box_min.Y.value() - margin;
+	double const max_x = box_max.X.value() + margin;
+	double const max_y = box_max.Y.value() + margin;
+
+	SVL<double, 32> x, y;
+	SVL<unsigned char, 32> bounded;
+
+	for (auto const & point : points) {
+		double const px = point.X.value();
+		double const py = point.Y.value();
+
+		bool const inside = px >= min_x && px <= max_x && py >= min_y && py <= max_y;
+		bounded.append(inside);
+
+		if (inside) {
+			x.append(px);
+			y.append(py);
+		}
+	}
+
+	int const tested = x.size();
+
+	SVL<unsigned char, 32> crossed, undecided;
+	if (tested > 0) {
+		loop_lanes const loop(rel.loopPoints());
+
+		pad(x, y);
+		crossings(loop, x, y, tested, crossed, undecided);
+	}
+
+	int slot = 0;
+	for (int index = 0; index < points.size(); index++) {
+		if (!bounded[index])
+			results.append(FaceRelation(inverted ? FaceRelationType::point_interior : FaceRelationType::point_exterior, nullptr));
+		else if (undecided[slot])
+			results.append(getPointRelation(rel, points[index]));
+		else if ((crossed[slot] != 0) != inverted)
+			results.append(FaceRelation(FaceRelationType::point_interior, nullptr));
+		else
+			results.append(FaceRelation(FaceRelationType::point_exterior, nullptr));
+
+		slot += bounded[index];
+	}
+}
+
+void getPointRelations(FLL<Pgrd> const & rel, SVL<Pgrd> const & points, SVL<FaceRelationType> & results) {
+	bool const inverted = Pgrd::area(rel) < 0;
+
+	SVL<double, 32> x, y;
+	for (auto const & point : points) {
+		x.append(point.X.value());
+		y.append(point.Y.value());
+	}
+
+	loop_lanes const loop(rel);
+
+	pad(x, y);
+
+	SVL<unsigned char, 32> crossed, undecided;
+	crossings(loop, x, y, points.size(), crossed, undecided);
+
+	for (int index = 0; index < points.size(); index++) {
+		if (undecided[index])
+			results.append(getPointRelation(rel, points[index]));
+		else if ((crossed[index] != 0) != inverted)
+			results.append(FaceRelationType::point_interior);
+		else
+			results.append(FaceRelationType::point_exterior);
+	}
+}
+
+void getSegmentTests(Pgrd const & start, Pgrd const & stop, SVL<Edge<Pgrd> *> const & edges, SVL<segment_test> & results) {
+	segment_lanes const packed(edges);
+
+	double const epsilon = grid_epsilon;
+
+	lanes const bound = lanes::set(4 * epsilon * epsilon);
+
+	lanes const query_x = lanes::set(start.X.value());
+	lanes const query_y = lanes::set(start.Y.value());
+	lanes const ax = lanes::set((stop.X - start.X).value());
+	lanes const ay = lanes::set((stop.Y - start.Y).value());
+	lanes const a_squared = squared(ax, ay);
+
+	for (int block = 0; block < packed.start_x.size(); block += lanes::width) {
+		lanes const bx = lanes::load(packed.delta_x.data() + block);
+		lanes const by = lanes::load(packed.delta_y.data() + block);
+		lanes const b_squared = squared(bx, by);
+
+		//the edge's ends relative to the query's start
+		lanes const sx = lanes::load(packed.start_x.data() + block) - query_x;
+		lanes const sy = lanes::load(packed.start_y.data() + block) - query_y;
+		lanes const ex = sx + bx;
+		lanes const ey = sy + by;
+
+		//the sides of the triangle each orientation test builds
+		lanes const start_to_start = squared(sx, sy);
+		lanes const start_to_end = squared(ex, ey);
+		lanes const end_to_start = squared(sx - ax, sy - ay);
+		lanes const end_to_end = squared(ex - ax, ey - ay);
+
+		//the edge's ends against the query, then the query's ends against the edge
+		lane_side const edge_start(ax * sy - ay * sx, max(a_squared, max(start_to_start, end_to_start)), bound);
+		lane_side const edge_end(ax * ey - ay * ex, max(a_squared, max(start_to_end, end_to_end)), bound);
+		lane_side const query_start(by * sx - bx * sy, max(b_squared, max(start_to_start, start_to_end)), bound);
+		lane_side const query_end(bx * (ay - sy) - by * (ax - sx), max(b_squared, max(end_to_start, end_to_end)), bound);
+
+		lanes const decided = (edge_start.left | edge_start.right) & (edge_end.left | edge_end.right) &
+			(query_start.left | query_start.right) & (query_end.left | query_end.right);
+
+		lanes const one_side = (edge_start.left & edge_end.left) | (edge_start.right & edge_end.right) |
+			(query_start.left & query_end.left) | (query_start.right & query_end.right);
+
+		//clearly not parallel, so getIntersect goes on to its orientation tests and the overlap tests are skipped
+		lanes const cross = ax * by - ay * bx;
+		lanes const angled = cross * cross > bound * max(a_squared, b_squared);
+
+		//with one segment clear to one side of the other, getIntersect fails, and when parallel the overlap tests
+		//need an end collinear with the other segment, which none are once every end is decided
+		lanes const apart = one_side & (angled | decided);
+
+		lanes const crossing = angled & ((edge_start.left & edge_end.right) | (edge_start.right & edge_end.left)) &
+			((query_start.left & query_end.right) | (query_start.right & query_end.left));
+
+		double position[lanes::width];
+		((by * sx - bx * sy) / cross).store(position);
+
+		int const apart_mask = apart.mask();
+		int const crossing_mask = crossing.mask();
+
+		for (int lane = 0; lane < lanes::width && block + lane < edges.size(); lane++) {
+			segment_test product;
+			product.position = 0;
+
+			if ((apart_mask >> lane) & 1) {
+				product.state = segment_apart;
+			}
+			else if ((crossing_mask >> lane) & 1) {
+				product.state = segment_crossing;
+				product.position = position[lane];
+			}
+			else {
+				product.state = segment_undecided;
+			}
+
+			results.append(product);
+		}
+	}
+}
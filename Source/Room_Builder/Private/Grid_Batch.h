@@ -0,0 +1,32 @@
+#pragma once
+#include "Grid_Region.h"
+
+/*
+
+Contains batched geometric kernels, testing many points against one loop, or one segment against many edges, in a single pass
+
+the operands are copied once into struct of arrays form and run in blocks of lanes,
+4 with AVX, 2 with SSE2, or 1 without either
+the lanes decide every test that lies clearly away from the loop or segment,
+the few within tolerance of an edge or vertex fall back to the scalar tests, so results always match them
+
+*/
+
+//classifies each point against the face, results[i] matches getPointRelation(rel, points[i])
+void getPointRelations(Face<Pgrd> & rel, SVL<Pgrd> const & points, SVL<FaceRelation> & results);
+
+//classifies each point against the loop, results[i] matches getPointRelation(rel, points[i])
+void getPointRelations(FLL<Pgrd> const & rel, SVL<Pgrd> const & points, SVL<FaceRelationType> & results);
+
+enum segment_test_state { segment_apart, segment_crossing, segment_undecided };
+
+struct segment_test {
+	segment_test_state state;
+	//for crossings, where the query meets the edge, 0 at its start and 1 at its stop
+	double position;
+};
+
+//tests the query segment against each edge, results[i] is for edges[i]
+//apart edges have no intersect and no overlap with the query, crossing edges pass getIntersect
+//undecided edges touch, overlap or lie within tolerance of the query, and need the scalar tests
+void getSegmentTests(Pgrd const & start, Pgrd const & stop, SVL<Edge<Pgrd> *> const & edges, SVL<segment_test> & results);
@@ -0,0 +1,289 @@
+#include "Grid_Building.h"
+#include "Grid_Batch.h"
+#include "Grid_Log.h"
+
+Region_List Type_Tracker::createRoom(Region_Suggestion const &suggested) {
+	Region_List final_room_set;
+
+	allocateBoundariesFromInto(suggested.boundaries, Nulls, final_room_set);
+
+	gridLog("room smalls");
+	removeSmallSections(final_room_set, min_room_width, Nulls);
+
+	gridLog("hall smalls");
+	removeSmallSections(Nulls, min_hall_width, Smalls);
+
+	Rooms.append(final_room_set);
+
+	return final_room_set;
+}
+
+Region_List Type_Tracker::createHall(Region_Suggestion const &suggested) {
+	Region_List final_hall_set;
+
+	allocateBoundariesFromInto(suggested.boundaries, Nulls, final_hall_set);
+
+	removeSmallSections(final_hall_set, min_hall_width, Nulls);
+	removeSmallSections(Nulls, min_hall_width, Smalls);
+
+	Halls.append(final_hall_set);
+
+	return final_hall_set;
+}
+
+Region_List Type_Tracker::createNull(Region_Suggestion const &suggested) {
+	Region_List final_null_set;
+
+	allocateBoundariesFromInto(suggested.boundaries, Exteriors, final_null_set);
+
+	removeSmallSections(final_null_set, min_room_width, Exteriors);
+
+	Nulls.append(final_null_set);
+
+	return final_null_set;
+}
+
+bool Region_Suggestion::contains(Pgrd const &test) {
+	for (auto region : boundaries)
+		if (getPointRelation(*region, test) != point_exterior)
+			return true;
+	return false;
+}
+
+bool Region_Suggestion::containsAny(SVL<Pgrd> const &tests) {
+	SVL<FaceRelationType> relations;
+
+	for (auto region : boundaries) {
+		relations.clear();
+		getPointRelations(*region, tests, relations);
+
+		for (auto relation : relations)
+			if (relation != point_exterior)
+				return true;
+	}
+	return false;
+}
+
+void clusterSuggestions(FLL<Region_Suggestion*> &suggested, grd const &tolerance) {
+	for (auto x = suggested.begin(); x != suggested.end();++x) {
+		for (auto y = x.next(); y != suggested.end();) {
+			//try and find a pair of centroids within tolerance
+			//a pair exists when any of y's centroids lies in x and any of x's lies in y
+			SVL<Pgrd> x_points;
+			for (auto x_p : x->centroids)
+				x_points.append(x_p);
+
+			SVL<Pgrd> y_points;
+			for (auto y_p : y->centroids)
+				y_points.append(y_p);
+
+			bool const seperate = !(x->containsAny(y_points) && y->containsAny(x_points));
+
+			//if found, merge all of y into x
+			if (seperate)
+				++y;
+			else {
+				x->centroids.absorb(y->centroids);
+				x->boundaries.absorb(y->boundaries);
+
+				auto absorbed = *y;
+				suggested.remove(absorbed);
+				delete absorbed;
+
+				y = x.next();
+			}
+		}
+	}
+}
+
+FLL<Region_Suggestion*> suggestDistribution(Pgrd const &A, Pgrd const &B, grd const &room_width, grd const &room_depth, grd const &min_hall_width, bool start_row, bool end_row) {
+	FLL<Region_Suggestion*> result;
+
+	Pgrd dir = B - A;
+	dir.Normalize();
+	Pgrd par(dir.Y, -dir.X);
+	par *= (room_depth + min_hall_width / 2);
+
+	grd full_segment = (B - A).Size() + (room_width * 2) - min_hall_width;
+	int rooms = (full_segment / room_width).value();
+	grd segment = full_segment / rooms;
+
+
+	int i = 0;
+	if (!start_row)
+		i++;
+
+	if (!end_row)
+		rooms--;
+
+	for (; i < rooms; i++) {
+		grd offset = (segment * i) - room_width + min_hall_width / 2;
+		Pgrd root = A + (dir * offset);
+
+		{
+
+			Region_Suggestion * suggest = new Region_Suggestion();
+
+			FLL<Pgrd> * bounds = new FLL<Pgrd>();
+			bounds->append(root);
+			bounds->append(root + (dir * segment));
+			bounds->append(root + par + (dir * segment));
+			bounds->append(root + par);
+
+			suggest->boundaries.append(bounds);
+			suggest->centroids.append(root + (par / 2) + (dir * segment / 2));
+
+			result.append(suggest);
+		}
+
+		{
+			Region_Suggestion * suggest = new Region_Suggestion();
+
+			FLL<Pgrd> * bounds = new FLL<Pgrd>();
+			bounds->append(root - par);
+			bounds->append(root - par + (dir * segment));
+			bounds->append(root + (dir * segment));
+			bounds->append(root);
+
+			suggest->boundaries.append(bounds);
+			suggest->centroids.append(root - (par / 2) + (dir * segment / 2));
+
+			result.append(suggest);
+		}
+	}
+
+	return result;
+}
+
+FLL<Pgrd> * wrapSegment(Pgrd const &A, Pgrd const &B, grd const &extent_perp, grd const &extent_ends) {
+	FLL<Pgrd> * result = new FLL<Pgrd>();
+
+	Pgrd dir = B - A;
+	dir.Normalize();
+
+	Pgrd par(-dir.Y, dir.X);
+
+	dir *= extent_ends;
+	par *= extent_perp;
+
+	result->append(A - dir - par);
+	result->append(A - dir + par);
+	result->append(B + dir + par);
+	result->append(B + dir - par);
+
+	return result;
+}
+
+void createBlockNulls(Type_Tracker &frame, FLL<rigid_line> const &list, Block_Dimensions const &dims) {
+	gridLog("Building Generation\n\n");
+	Region_Suggestion null_suggestion;
+
+	grd const min_hall_width = frame.min_hall_width;
+
+	for (auto x : list) {
+
+		FLL<Pgrd> * null_boundary = wrapSegment(x.start, x.end, dims.room_depth + min_hall_width / 2, dims.room_depth - min_hall_width / 2);
+
+		null_suggestion.boundaries.append(null_boundary);
+	}
+
+	frame.createNull(null_suggestion);
+}
+
+void createBlockHalls(Type_Tracker &frame, FLL<rigid_line> const &list, Block_Dimensions const &dims) {
+	gridLog("Hall Generation\n\n\n");
+	Region_Suggestion hall_suggestion;
+
+	for (auto x : list) {
+
+		FLL<Pgrd> * hall_boundary = wrapSegment(x.start, x.end, dims.hall_width / 2, dims.hall_width / 2);
+
+		hall_suggestion.boundaries.append(hall_boundary);
+	}
+
+	frame.createHall(hall_suggestion);
+}
+
+FLL<Region_Suggestion *> suggestBlockRooms(Type_Tracker &frame, FLL<rigid_line> const &list, Block_Dimensions const &dims) {
+	gridLog("Stuff Generation\n\n\n");
+
+	FLL<Region_Suggestion *> room_list;
+
+	grd const min_hall_width = frame.min_hall_width;
+
+	for (auto x : list) {
+		auto p = suggestDistribution(x.start, x.end, dims.room_width, dims.room_depth, min_hall_width, x.start_row, x.end_row);
+		room_list.absorb(p);
+	}
+
+	clusterSuggestions(room_list, dims.room_width);
+
+	return room_list;
+}
+
+void resolveBlockSmalls(Type_Tracker &frame) {
+	gridLog("SMALLS\n");
+
+	frame.Smalls.absorb(frame.Nulls);
+
+	Region_List all_smalls;
+	Region_List smalls;
+
+	for (auto small : frame.Smalls) {
+
+		//filters for neighboring rooms, removes them from frame consideration for potential edits
+		Region_List neighbors = small->getNeighbors();
+		Region_List room_neighbors;
+		for (auto neighbor : neighbors)
+			if (frame.Rooms.remove(neighbor))
+				room_neighbors.append(neighbor);
+
+		Region_List rooms;
+
+
+		smalls.append(small);
+
+		Region_List novel_smalls;
+		Region_List relevant;
+
+		for (auto potential : room_neighbors) {
+			relevant.append(potential);
+
+			for (auto part : smalls) {
+				if (!merge(potential, part)) {
+					novel_smalls.append(part);
+				}
+			}
+
+			removeSmallSections(relevant, frame.min_room_width, novel_smalls);
+
+			smalls.clear();
+
+			rooms.absorb(relevant);
+			smalls.absorb(novel_smalls);
+		}
+
+		frame.Rooms.absorb(rooms);
+		all_smalls.absorb(smalls);
+	}
+
+	frame.Smalls.clear();
+	frame.Smalls.absorb(all_smalls);
+}
+
+void buildingFromBlock(Type_Tracker &frame, FLL<rigid_line> const &list, Block_Dimensions const &dims) {
+	createBlockNulls(frame, list, dims);
+
+	createBlockHalls(frame, list, dims);
+
+	auto room_list = suggestBlockRooms(frame, list, dims);
+
+	gridLog("ROOMS\n");
+	for (auto room_suggestion : room_list) {
+		frame.createRoom(*room_suggestion);
+
+		delete room_suggestion;
+	}
+
+	resolveBlockSmalls(frame);
+}
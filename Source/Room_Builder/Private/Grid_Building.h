@@ -0,0 +1,128 @@
+#pragma once
+#include "Grid_Tools.h"
+
+/*
+
+Contains the engine independent stages of building generation
+regions are tracked by type, and allocated from suggestions laid out along build lines
+
+*/
+
+//a set of boundaries to be allocated together, and the points that identify it
+struct Region_Suggestion {
+	FLL<Pgrd> centroids;
+	FLL<FLL<Pgrd> *> boundaries;
+
+	Region_Suggestion() {
+
+	}
+	~Region_Suggestion() {
+		for (auto boundary : boundaries)
+			delete boundary;
+	}
+
+	Region_Suggestion(Region_Suggestion &&) = delete;
+	Region_Suggestion(Region_Suggestion const &) = delete;
+
+	bool contains(Pgrd const &test);
+	//true if any of the points lies within, the points are tested against each boundary in one batch
+	bool containsAny(SVL<Pgrd> const &tests);
+};
+
+struct rigid_line {
+	Pgrd start;
+	Pgrd end;
+
+	bool start_row;
+	bool end_row;
+
+	rigid_line() {
+
+	}
+	rigid_line(Pgrd const &s, Pgrd const &e, bool s_row, bool e_row) {
+		start = s;
+		end = e;
+
+		start_row = s_row;
+		end_row = e_row;
+	}
+};
+
+//Used to track regions within a DCEL and categorize them
+struct Type_Tracker {
+	DCEL<Pgrd> * system;
+
+	float min_room_width;
+	float min_hall_width;
+
+	Region_List Exteriors;
+	Region_List Nulls;
+	Region_List Rooms;
+	Region_List Halls;
+	Region_List Smalls;
+
+	bool isRoom(Region<Pgrd> const * target) {
+		for (auto room : Rooms) {
+			if (room == target) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	Type_Tracker(DCEL<Pgrd> * sys, float room, float hall) {
+		system = sys;
+
+		Exteriors.append(sys->region());
+
+		min_room_width = room;
+		min_hall_width = hall;
+	}
+
+	Region_List createRoom(Region_Suggestion const &suggested);
+	Region_List createHall(Region_Suggestion const &suggested);
+	Region_List createNull(Region_Suggestion const &suggested);
+};
+
+//the dimensions used to lay out a block of rooms along build lines
+struct Block_Dimensions {
+	grd room_width;
+	grd room_depth;
+	grd hall_width;
+};
+
+//merges suggestions whose centroids are mutually contained
+void clusterSuggestions(FLL<Region_Suggestion*> &suggested, grd const &tolerance);
+
+//lays out rows of room suggestions on either side of the segment A-B
+FLL<Region_Suggestion*> suggestDistribution(Pgrd const &A, Pgrd const &B, grd const &room_width, grd const &room_depth,
+	grd const &min_hall_width, bool start_row = true, bool end_row = true);
+
+//returns a rectangle surrounding the segment A-B
+FLL<Pgrd> * wrapSegment(Pgrd const &A, Pgrd const &B, grd const &extent_perp, grd const &extent_ends);
+
+///<summary>
+///<para>Allocates the null space surrounding every build line from the exteriors.</para>
+///</summary>
+void createBlockNulls(Type_Tracker &frame, FLL<rigid_line> const &list, Block_Dimensions const &dims);
+
+///<summary>
+///<para>Allocates the halls along every build line from the nulls.</para>
+///</summary>
+void createBlockHalls(Type_Tracker &frame, FLL<rigid_line> const &list, Block_Dimensions const &dims);
+
+///<summary>
+///<para>Lays out and clusters the room suggestions along every build line.</para>
+///<para>The caller owns the returned suggestions.</para>
+///</summary>
+FLL<Region_Suggestion *> suggestBlockRooms(Type_Tracker &frame, FLL<rigid_line> const &list, Block_Dimensions const &dims);
+
+///<summary>
+///<para>Moves all remaining nulls to smalls, then folds smalls into their neighboring rooms where widths allow.</para>
+///</summary>
+void resolveBlockSmalls(Type_Tracker &frame);
+
+///<summary>
+///<para>Runs the full null, hall, and room allocation pipeline for a block of build lines.</para>
+///</summary>
+void buildingFromBlock(Type_Tracker &frame, FLL<rigid_line> const &list, Block_Dimensions const &dims);
@@ -0,0 +1,390 @@
+#include "Grid_Index.h"
+#include "Grid_Batch.h"
+
+namespace
+{
+	//covers the tolerance segment tests apply, both to their end points and their parametric ranges
+	double padding(double length) {
+		return 4 * grid_epsilon * (length + 1);
+	}
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//         Edge_Grid
+
+void Edge_Grid::insert(Edge<Pgrd> * edge, int order) {
+	Pgrd const & A = edge->getStart()->getPosition();
+	Pgrd const & B = edge->getEnd()->getPosition();
+
+	double const pad = padding(edge->getLength().value());
+
+	grid->insert(edge, order,
+		std::fmin(A.X.value(), B.X.value()) - pad, std::fmin(A.Y.value(), B.Y.value()) - pad,
+		std::fmax(A.X.value(), B.X.value()) + pad, std::fmax(A.Y.value(), B.Y.value()) + pad);
+}
+
+Edge_Grid::Edge_Grid(SVL<Edge<Pgrd> *> const & edges) {
+	double min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+	bool found = false;
+
+	auto include = [&](Pgrd const & position) {
+		if (!found || position.X.value() < min_x) min_x = position.X.value();
+		if (!found || position.Y.value() < min_y) min_y = position.Y.value();
+		if (!found || position.X.value() > max_x) max_x = position.X.value();
+		if (!found || position.Y.value() > max_y) max_y = position.Y.value();
+
+		found = true;
+	};
+
+	for (auto edge : edges) {
+		include(edge->getStart()->getPosition());
+		include(edge->getEnd()->getPosition());
+	}
+
+	grid = new Box_Grid<Edge<Pgrd> *>(min_x, min_y, max_x, max_y, edges.size());
+
+	front = 0;
+	back = 0;
+
+	for (auto edge : edges)
+		insert(edge, back++);
+}
+
+Edge_Grid::~Edge_Grid() {
+	delete grid;
+}
+
+void Edge_Grid::push(Edge<Pgrd> * edge) {
+	insert(edge, --front);
+}
+
+void Edge_Grid::append(Edge<Pgrd> * edge) {
+	insert(edge, back++);
+}
+
+void Edge_Grid::query(Pgrd const & start, Pgrd const & stop, SVL<Edge<Pgrd> *> & result) const {
+	double const pad = padding((stop - start).Size().value());
+
+	SVL<Box_Grid<Edge<Pgrd> *>::entry, 32> hits;
+
+	grid->query(
+		std::fmin(start.X.value(), stop.X.value()) - pad, std::fmin(start.Y.value(), stop.Y.value()) - pad,
+		std::fmax(start.X.value(), stop.X.value()) + pad, std::fmax(start.Y.value(), stop.Y.value()) + pad,
+		hits);
+
+	for (auto const & hit : hits)
+		result.append(hit.item);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//         Face_Index
+
+Face_Index::Face_Index(FLL<Face<Pgrd> *> const & source) {
+	double min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+	bool found = false;
+
+	for (auto face : source) {
+		faces.append(face);
+
+		Pgrd const & box_min = face->getBoxMin();
+		Pgrd const & box_max = face->getBoxMax();
+
+		if (!found || box_min.X.value() < min_x) min_x = box_min.X.value();
+		if (!found || box_min.Y.value() < min_y) min_y = box_min.Y.value();
+		if (!found || box_max.X.value() > max_x) max_x = box_max.X.value();
+		if (!found || box_max.Y.value() > max_y) max_y = box_max.Y.value();
+
+		found = true;
+	}
+
+	grid = new Box_Grid<int>(min_x, min_y, max_x, max_y, faces.size());
+
+	for (int order = 0; order < faces.size(); order++) {
+		Face<Pgrd> * face = faces[order];
+
+		if (face->getArea() < 0) {
+			inverted.append(order);
+		}
+		else {
+			Pgrd const & box_min = face->getBoxMin();
+			Pgrd const & box_max = face->getBoxMax();
+
+			//points outside the bounds are left to inBounds, the grid only needs to keep every point inside
+			double const pad = padding(std::fmax(box_max.X.value() - box_min.X.value(), box_max.Y.value() - box_min.Y.value()));
+
+			grid->insert(order, order, box_min.X.value() - pad, box_min.Y.value() - pad, box_max.X.value() + pad, box_max.Y.value() + pad);
+		}
+	}
+}
+
+Face_Index::~Face_Index() {
+	delete grid;
+}
+
+void Face_Index::candidates(Pgrd const & point, SVL<int> & result) const {
+	SVL<Box_Grid<int>::entry, 32> hits;
+
+	grid->query(point.X.value(), point.Y.value(), point.X.value(), point.Y.value(), hits);
+
+	//merge the bounded hits with the inverted faces, keeping list order
+	int hit = 0;
+	int other = 0;
+
+	while (hit < hits.size() || other < inverted.size()) {
+		if (other == inverted.size() || (hit < hits.size() && hits[hit].order < inverted[other]))
+			result.append(hits[hit++].order);
+		else
+			result.append(inverted[other++]);
+	}
+}
+
+void Face_Index::containing(SVL<Pgrd> const & points, SVL<int> & offsets, SVL<int> & result) const {
+	//gather every point's candidates, then test each face against all of its points in one batch
+	SVL<int> candidate_offsets;
+	SVL<int> candidate_orders;
+
+	for (auto const & point : points) {
+		candidate_offsets.append(candidate_orders.size());
+		candidates(point, candidate_orders);
+	}
+	candidate_offsets.append(candidate_orders.size());
+
+	//bucket the candidate slots by face
+	SVL<int> bucket_offsets;
+	for (int order = 0; order <= faces.size(); order++)
+		bucket_offsets.append(0);
+
+	for (auto order : candidate_orders)
+		bucket_offsets[order + 1]++;
+
+	for (int order = 0; order < faces.size(); order++)
+		bucket_offsets[order + 1] += bucket_offsets[order];
+
+	SVL<int> bucket_slots;
+	SVL<int> bucket_points;
+	for (int slot = 0; slot < candidate_orders.size(); slot++) {
+		bucket_slots.append(0);
+		bucket_points.append(0);
+	}
+
+	{
+		SVL<int> fill;
+		for (int order = 0; order < faces.size(); order++)
+			fill.append(bucket_offsets[order]);
+
+		for (int index = 0; index < points.size(); index++) {
+			for (int slot = candidate_offsets[index]; slot < candidate_offsets[index + 1]; slot++) {
+				int const at = fill[candidate_orders[slot]]++;
+				bucket_slots[at] = slot;
+				bucket_points[at] = index;
+			}
+		}
+	}
+
+	SVL<bool> interior;
+	for (int slot = 0; slot < candidate_orders.size(); slot++)
+		interior.append(false);
+
+	SVL<Pgrd> batch;
+	SVL<FaceRelation> relations;
+
+	for (int order = 0; order < faces.size(); order++) {
+		if (bucket_offsets[order] == bucket_offsets[order + 1])
+			continue;
+
+		batch.clear();
+		relations.clear();
+
+		for (int at = bucket_offsets[order]; at < bucket_offsets[order + 1]; at++)
+			batch.append(points[bucket_points[at]]);
+
+		getPointRelations(*faces[order], batch, relations);
+
+		for (int at = bucket_offsets[order]; at < bucket_offsets[order + 1]; at++)
+			interior[bucket_slots[at]] = relations[at - bucket_offsets[order]].type == FaceRelationType::point_interior;
+	}
+
+	for (int index = 0; index < points.size(); index++) {
+		offsets.append(result.size());
+
+		for (int slot = candidate_offsets[index]; slot < candidate_offsets[index + 1]; slot++)
+			if (interior[slot])
+				result.append(candidate_orders[slot]);
+	}
+
+	offsets.append(result.size());
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//         Region_Locator
+
+namespace
+{
+	//whether point lies in the bounds of the segment, padded as the edge grid pads them
+	bool nearSegment(Pgrd const & point, Pgrd const & A, Pgrd const & B) {
+		double const pad = padding((B - A).Size().value());
+
+		return point.X.value() >= std::fmin(A.X.value(), B.X.value()) - pad && point.X.value() <= std::fmax(A.X.value(), B.X.value()) + pad &&
+			point.Y.value() >= std::fmin(A.Y.value(), B.Y.value()) - pad && point.Y.value() <= std::fmax(A.Y.value(), B.Y.value()) + pad;
+	}
+}
+
+Region_Locator::Region_Locator(Region<Pgrd> * target, Edge_Grid const * grid) : grid(nullptr) {
+	int edges = 0;
+
+	for (auto face : target->getBounds()) {
+		face_order entry;
+		entry.face = face;
+		entry.order = faces.size();
+
+		faces.append(face);
+		by_face.append(entry);
+
+		edges += face->getLoopSize();
+	}
+
+	std::sort(by_face.data(), by_face.data() + by_face.size());
+
+	if (edges >= direct_limit)
+		this->grid = grid;
+}
+
+bool Region_Locator::clear(Pgrd const & point) const {
+	SVL<Edge<Pgrd> *> nearby;
+	grid->query(point, point, nearby);
+
+	for (auto edge : nearby) {
+		Pgrd const & A = edge->getStart()->getPosition();
+		Pgrd const & B = edge->getEnd()->getPosition();
+
+		if (nearSegment(point, A, B) && orientation(A, B, point) == orient_collinear)
+			return false;
+	}
+
+	return true;
+}
+
+bool Region_Locator::walk(Pgrd const & start, Pgrd const & stop, SVL<bool> & inside) const {
+	SVL<Edge<Pgrd> *> nearby;
+	grid->query(start, stop, nearby);
+
+	SVL<face_order> crossed;
+
+	for (auto edge : nearby) {
+		Pgrd const & A = edge->getStart()->getPosition();
+		Pgrd const & B = edge->getEnd()->getPosition();
+
+		orientation_state const start_side = orientation(A, B, start);
+		orientation_state const stop_side = orientation(A, B, stop);
+		orientation_state const A_side = orientation(start, stop, A);
+		orientation_state const B_side = orientation(start, stop, B);
+
+		//an end of the walk on the edge, or a vertex on the walk
+		if ((stop_side == orient_collinear && nearSegment(stop, A, B)) ||
+			(start_side == orient_collinear && nearSegment(start, A, B)) ||
+			(A_side == orient_collinear && nearSegment(A, start, stop)) ||
+			(B_side == orient_collinear && nearSegment(B, start, stop)))
+			return false;
+
+		//the walk and edge on one line may overlap
+		if ((start_side == orient_collinear && stop_side == orient_collinear) ||
+			(A_side == orient_collinear && B_side == orient_collinear))
+			return false;
+
+		//any other collinear end lies on the line beyond the other segment, where nothing is crossed
+		if (start_side == orient_collinear || stop_side == orient_collinear ||
+			A_side == orient_collinear || B_side == orient_collinear)
+			continue;
+
+		if (start_side != stop_side && A_side != B_side) {
+			face_order entry;
+			entry.face = edge->getFace();
+			entry.order = -1;
+
+			crossed.append(entry);
+		}
+	}
+
+	//crossings and faces are both sorted by face, so each crossing finds its face's order in one merge
+	std::sort(crossed.data(), crossed.data() + crossed.size());
+
+	int index = 0;
+	for (auto const & crossing : crossed) {
+		while (by_face[index] < crossing)
+			index++;
+
+		int const order = by_face[index].order;
+		inside[order] = !inside[order];
+	}
+
+	return true;
+}
+
+located Region_Locator::place(Pgrd const & point, SVL<bool> * inside) const {
+	located result(FaceRelation(FaceRelationType::point_interior, nullptr), nullptr);
+	Face<Pgrd> * outer = nullptr;
+
+	for (auto face : faces) {
+		FaceRelation const relation = getPointRelation(*face, point);
+
+		if (result.relation.type == FaceRelationType::point_interior && relation.type != FaceRelationType::point_interior) {
+			result = located(relation, face);
+
+			if (inside == nullptr)
+				return result;
+		}
+
+		if (outer == nullptr && face->getArea() > 0)
+			outer = face;
+
+		if (inside != nullptr)
+			inside->append(relation.type == FaceRelationType::point_interior);
+	}
+
+	if (result.relation.type == FaceRelationType::point_interior)
+		result.face = outer;
+
+	return result;
+}
+
+located Region_Locator::decide(SVL<bool> const & inside) const {
+	for (int index = 0; index < faces.size(); index++)
+		if (!inside[index])
+			return located(FaceRelation(FaceRelationType::point_exterior, nullptr), faces[index]);
+
+	for (auto face : faces)
+		if (face->getArea() > 0)
+			return located(FaceRelation(FaceRelationType::point_interior, nullptr), face);
+
+	return located(FaceRelation(FaceRelationType::point_interior, nullptr), nullptr);
+}
+
+located Region_Locator::locate(Pgrd const & point, locate_hint & hint) const {
+	if (grid == nullptr)
+		return place(point, nullptr);
+
+	SVL<bool> inside;
+
+	bool found = false;
+
+	if (hint.valid) {
+		inside = hint.inside;
+		found = clear(point) && walk(hint.point, point, inside);
+	}
+
+	if (!found) {
+		//the point is placed directly, as contains places it, and only seeds a hint when clear of every edge
+		inside.clear();
+
+		located const result = place(point, &inside);
+
+		if (result.relation.type == FaceRelationType::point_on_boundary || !clear(point))
+			return result;
+	}
+
+	hint.point = point;
+	hint.inside = inside;
+	hint.valid = true;
+
+	return decide(inside);
+}
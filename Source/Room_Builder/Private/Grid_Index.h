@@ -0,0 +1,258 @@
+#pragma once
+#include "Grid_Region.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+/*
+
+Contains uniform grids over edges and faces, used to limit geometric tests to nearby elements
+
+elements are bucketed by their bounding box, padded to cover the tolerance of the tests that follow
+every element is given an order when inserted, and queries return elements sorted by that order,
+so results match a linear scan of the list the grid mirrors
+
+*/
+
+//a uniform grid of items bucketed by bounding box
+template <class _T>
+class Box_Grid {
+public:
+	struct entry {
+		_T item;
+		int order;
+
+		double min_x;
+		double min_y;
+		double max_x;
+		double max_y;
+
+		bool operator<(entry const & target) const {
+			return order < target.order;
+		}
+	};
+
+private:
+	enum : int { max_cells_per_axis = 256 };
+
+	SVL<entry, 4> * cells;
+	int columns;
+	int rows;
+
+	double origin_x;
+	double origin_y;
+	double cell_size;
+
+	int cellX(double x) const {
+		int const cell = (int)std::floor((x - origin_x) / cell_size);
+		return cell < 0 ? 0 : (cell >= columns ? columns - 1 : cell);
+	}
+	int cellY(double y) const {
+		int const cell = (int)std::floor((y - origin_y) / cell_size);
+		return cell < 0 ? 0 : (cell >= rows ? rows - 1 : cell);
+	}
+
+public:
+	//sized for roughly one item per cell over the given extent
+	//items outside the extent are kept in the border cells
+	Box_Grid(double min_x, double min_y, double max_x, double max_y, int count) {
+		double const extent = std::fmax(max_x - min_x, max_y - min_y);
+		int const per_axis = std::min<int>(max_cells_per_axis, (int)std::ceil(std::sqrt((double)count)) + 1);
+
+		cell_size = extent > 0 ? extent / per_axis : 1;
+		origin_x = min_x;
+		origin_y = min_y;
+
+		columns = std::min<int>(max_cells_per_axis, (int)std::floor((max_x - min_x) / cell_size) + 1);
+		rows = std::min<int>(max_cells_per_axis, (int)std::floor((max_y - min_y) / cell_size) + 1);
+
+		cells = new SVL<entry, 4>[columns * rows];
+	}
+	~Box_Grid() {
+		delete[] cells;
+	}
+
+	Box_Grid(Box_Grid &&) = delete;
+	Box_Grid(Box_Grid const &) = delete;
+
+	void insert(_T item, int order, double min_x, double min_y, double max_x, double max_y) {
+		entry product;
+		product.item = item;
+		product.order = order;
+		product.min_x = min_x;
+		product.min_y = min_y;
+		product.max_x = max_x;
+		product.max_y = max_y;
+
+		int const x_end = cellX(max_x);
+		int const y_end = cellY(max_y);
+
+		for (int y = cellY(min_y); y <= y_end; y++)
+			for (int x = cellX(min_x); x <= x_end; x++)
+				cells[y * columns + x].append(product);
+	}
+
+	//appends to result every entry whose box overlaps the query box, once each, sorted by order
+	template <int _N>
+	void query(double min_x, double min_y, double max_x, double max_y, SVL<entry, _N> & result) const {
+		int const first = result.size();
+
+		int const x_end = cellX(max_x);
+		int const y_end = cellY(max_y);
+
+		for (int y = cellY(min_y); y <= y_end; y++) {
+			for (int x = cellX(min_x); x <= x_end; x++) {
+				for (auto const & focus : cells[y * columns + x]) {
+					if (focus.max_x < min_x || focus.min_x > max_x || focus.max_y < min_y || focus.min_y > max_y)
+						continue;
+
+					result.append(focus);
+				}
+			}
+		}
+
+		//items spanning several cells are found once per cell
+		std::sort(result.data() + first, result.data() + result.size());
+
+		int kept = first;
+		for (int index = first; index < result.size(); index++) {
+			if (index == first || result[index].order != result[kept - 1].order) {
+				result[kept] = result[index];
+				kept++;
+			}
+		}
+
+		while (result.size() > kept)
+			result.removeAt(result.size() - 1);
+	}
+};
+
+//a grid of edges, for segment intersection tests
+//an edge keeps its cells when it is subdivided, the pieces always lie within the original extent
+class Edge_Grid {
+	Box_Grid<Edge<Pgrd> *> * grid;
+
+	//orders of front and back insertions, front insertions precede every earlier edge
+	int front;
+	int back;
+
+	void insert(Edge<Pgrd> * edge, int order);
+
+public:
+	//builds over the edges, in list order
+	Edge_Grid(SVL<Edge<Pgrd> *> const & edges);
+	~Edge_Grid();
+
+	Edge_Grid(Edge_Grid &&) = delete;
+	Edge_Grid(Edge_Grid const &) = delete;
+
+	//adds an edge ahead of all others, mirrors SVL::push
+	void push(Edge<Pgrd> * edge);
+	//adds an edge behind all others, mirrors SVL::append
+	void append(Edge<Pgrd> * edge);
+
+	//appends to result every edge whose padded bounds overlap the padded bounds of the segment
+	void query(Pgrd const & start, Pgrd const & stop, SVL<Edge<Pgrd> *> & result) const;
+};
+
+//a grid of faces, for point containment tests
+//faces are keyed by their cached bounds, inverted faces contain everything outside their bounds and are always tested
+//the faces must not be modified while indexed
+class Face_Index {
+	Box_Grid<int> * grid;
+
+	SVL<Face<Pgrd> *> faces;
+	SVL<int> inverted;
+
+	//appends the orders of the faces whose bounds may hold the point, ascending
+	void candidates(Pgrd const & point, SVL<int> & result) const;
+
+public:
+	//builds over the faces, a face's order is its position in the list
+	Face_Index(FLL<Face<Pgrd> *> const & source);
+	~Face_Index();
+
+	Face_Index(Face_Index &&) = delete;
+	Face_Index(Face_Index const &) = delete;
+
+	int size() const {
+		return faces.size();
+	}
+	Face<Pgrd> * operator[](int order) const {
+		return faces[order];
+	}
+
+	//the orders of the faces each point is interior to, ascending, those for points[i] are result[offsets[i]] up to result[offsets[i + 1]]
+	//each face is tested against all of its candidate points at once
+	void containing(SVL<Pgrd> const & points, SVL<int> & offsets, SVL<int> & result) const;
+};
+
+//where a region locator last placed a point, so the next query can walk from it
+struct locate_hint {
+	Pgrd point;
+	//whether point is interior to each face of the region, in bounds order
+	SVL<bool> inside;
+	bool valid;
+
+	locate_hint() {
+		valid = false;
+	}
+};
+
+//a point placed in a region, and the face of the region that decides its relation
+//that is the face of the edge it lies on, the first face it is outside of, or the outer face holding it,
+//an interior point of a region with no outer face has none
+struct located {
+	FaceRelation relation;
+	Face<Pgrd> * face;
+
+	located(FaceRelation const & relation, Face<Pgrd> * face) : relation(relation), face(face) {
+	}
+};
+
+//locates points in a region by walking from the last point placed
+//the walk crosses the edges between the hint and the point, found through a grid over the region's edges,
+//and each crossing flips the state of the face the edge bounds
+//the walk gives way to a direct test whenever a point or vertex lies within tolerance of what it is tested against,
+//so points on the boundary are always placed as contains places them, small regions are always tested directly
+//the grid is the caller's, it must hold every edge of the region, and the region must not be modified while indexed
+class Region_Locator {
+	enum : int { direct_limit = 32 };
+
+	//a face and its position in bounds order, kept sorted by face so crossings can be matched to faces in one pass
+	struct face_order {
+		Face<Pgrd> * face;
+		int order;
+
+		bool operator<(face_order const & target) const {
+			return std::less<Face<Pgrd> *>()(face, target.face);
+		}
+	};
+
+	SVL<Face<Pgrd> *> faces;
+	SVL<face_order> by_face;
+	Edge_Grid const * grid;
+
+	//false if the point lies within tolerance of an edge near it
+	bool clear(Pgrd const & point) const;
+
+	//flips inside for the face of every edge crossed from start to stop, false if the walk touches an edge or vertex
+	bool walk(Pgrd const & start, Pgrd const & stop, SVL<bool> & inside) const;
+
+	//tests the point against every face, as contains does, filling inside when it is given
+	located place(Pgrd const & point, SVL<bool> * inside) const;
+
+	//the face deciding an exterior or interior relation, from the state of each face
+	located decide(SVL<bool> const & inside) const;
+
+public:
+	//regions with few edges are tested directly, and grid may then be null
+	Region_Locator(Region<Pgrd> * target, Edge_Grid const * grid);
+
+	Region_Locator(Region_Locator &&) = delete;
+	Region_Locator(Region_Locator const &) = delete;
+
+	//the relation of the point to the region, as contains returns it, and the face deciding it
+	//hint is read as the place to walk from, and is left at the point when the point is clear of every edge
+	located locate(Pgrd const & point, locate_hint & hint) const;
+};
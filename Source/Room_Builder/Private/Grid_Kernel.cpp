@@ -0,0 +1,59 @@
+#include "Grid_Kernel.h"
+
+namespace
+{
+	//error free transformations, x is the rounded result and y the rounding error
+	inline void twoSum(double a, double b, double &x, double &y) {
+		x = a + b;
+		double const b_virtual = x - a;
+		double const a_virtual = x - b_virtual;
+		y = (a - a_virtual) + (b - b_virtual);
+	}
+
+	inline void twoProduct(double a, double b, double &x, double &y) {
+		x = a * b;
+		y = std::fma(a, b, -x);
+	}
+
+	//adds b to the nonoverlapping expansion e, the components stay in increasing magnitude
+	int growExpansion(double * e, int e_length, double b) {
+		int length = 0;
+		double Q = b;
+
+		for (int i = 0; i < e_length; i++) {
+			double h;
+			twoSum(Q, e[i], Q, h);
+
+			if (h != 0)
+				e[length++] = h;
+		}
+
+		if (Q != 0)
+			e[length++] = Q;
+
+		return length;
+	}
+}
+
+double orient2dExact(double ax, double ay, double bx, double by, double cx, double cy) {
+	//ax * by - ay * bx + bx * cy - by * cx + cx * ay - cy * ax
+	double const terms[6][2] = {
+		{ ax, by }, { -ay, bx },
+		{ bx, cy }, { -by, cx },
+		{ cx, ay }, { -cy, ax },
+	};
+
+	double expansion[12];
+	int length = 0;
+
+	for (auto const & term : terms) {
+		double x, y;
+		twoProduct(term[0], term[1], x, y);
+
+		length = growExpansion(expansion, length, y);
+		length = growExpansion(expansion, length, x);
+	}
+
+	//the largest component carries the sign
+	return length > 0 ? expansion[length - 1] : 0;
+}
@@ -0,0 +1,194 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+/*
+
+Contains the coordinate kernels grd can be built on
+
+a kernel fixes the storage of a coordinate, its arithmetic, and the tolerance comparisons apply
+the kernel is chosen at compile time, define one of
+	GRID_KERNEL_FLOAT	float storage, half the memory of the default at a coarser tolerance
+	GRID_KERNEL_LATTICE	values snapped to a 2^-40 lattice in int64, exact orientation, 128 bit products
+otherwise coordinates are doubles compared within a fixed epsilon
+
+*/
+
+//exact orientation of three points given as doubles, see floating_kernel::orient2d
+double orient2dExact(double ax, double ay, double bx, double by, double cx, double cy);
+
+//floating point storage, comparisons allow a fixed tolerance either way
+template <class _T>
+struct floating_kernel {
+	typedef _T storage;
+
+	//float carries roughly 7 digits, so its tolerance is coarser
+	static constexpr double tolerance() {
+		return sizeof(_T) < sizeof(double) ? .001 : .000001;
+	}
+
+	static constexpr double toDouble(storage a) {
+		return a;
+	}
+	static constexpr storage fromDouble(double a) {
+		return (storage)a;
+	}
+
+	static constexpr storage negate(storage a) {
+		return -a;
+	}
+	static constexpr storage add(storage a, storage b) {
+		return a + b;
+	}
+	static constexpr storage subtract(storage a, storage b) {
+		return a - b;
+	}
+	static constexpr storage multiply(storage a, storage b) {
+		return a * b;
+	}
+	static constexpr storage divide(storage a, storage b) {
+		return a / b;
+	}
+	static constexpr storage scale(storage a, double factor) {
+		return (storage)(a * factor);
+	}
+	static constexpr storage shrink(storage a, double factor) {
+		return (storage)(a / factor);
+	}
+	static storage sqrt(storage a) {
+		return std::sqrt(a);
+	}
+
+	//twice the signed area of a, b, c
+	//a double precision estimate is returned unless its error bound cannot rule out a sign error,
+	//in which case the determinant is evaluated exactly
+	static double orient2d(storage ax, storage ay, storage bx, storage by, storage cx, storage cy) {
+		//relative error bound of the double precision determinant, (3 + 16 * eps) * eps
+		double const bound_factor = (3.0 + 16.0 * 1.1102230246251565e-16) * 1.1102230246251565e-16;
+
+		double const left = ((double)ax - cx) * ((double)by - cy);
+		double const right = ((double)ay - cy) * ((double)bx - cx);
+		double const det = left - right;
+
+		double const bound = bound_factor * (std::fabs(left) + std::fabs(right));
+
+		if (det > bound || -det > bound)
+			return det;
+
+		return orient2dExact(ax, ay, bx, by, cx, cy);
+	}
+
+	static constexpr bool equal(storage a, storage b) {
+		return (a + tolerance() > b && a - tolerance() < b);
+	}
+	static constexpr bool notEqual(storage a, storage b) {
+		return (a + tolerance() < b || a - tolerance() > b);
+	}
+	static constexpr bool greater(storage a, storage b) {
+		return a - tolerance() > b;
+	}
+	static constexpr bool less(storage a, storage b) {
+		return a + tolerance() < b;
+	}
+	static constexpr bool greaterEqual(storage a, storage b) {
+		return a + tolerance() > b;
+	}
+	static constexpr bool lessEqual(storage a, storage b) {
+		return a - tolerance() < b;
+	}
+};
+
+typedef floating_kernel<double> double_kernel;
+typedef floating_kernel<float> float_kernel;
+
+#if defined(__SIZEOF_INT128__)
+
+//fixed point storage on a lattice of 2^-40, products and quotients are formed in 128 bits and snapped back
+//grd also carries ratios, squared lengths and areas, so the lattice is fine enough that those stay
+//resolved, which leaves every magnitude, squared lengths and areas included, below 2^23
+struct lattice_kernel {
+	typedef int64_t storage;
+
+	static constexpr int shift = 40;
+
+	//comparisons allow about a millionth either way, as the default kernel does
+	static constexpr storage slack = (storage)1 << 20;
+
+	static constexpr double resolution() {
+		return 1.0 / ((int64_t)1 << shift);
+	}
+	static constexpr double tolerance() {
+		return slack * resolution();
+	}
+
+	static constexpr double toDouble(storage a) {
+		return a * resolution();
+	}
+	static constexpr storage fromDouble(double a) {
+		return (storage)(a * ((int64_t)1 << shift) + (a < 0 ? -.5 : .5));
+	}
+
+	static constexpr storage negate(storage a) {
+		return -a;
+	}
+	static constexpr storage add(storage a, storage b) {
+		return a + b;
+	}
+	static constexpr storage subtract(storage a, storage b) {
+		return a - b;
+	}
+	static constexpr storage multiply(storage a, storage b) {
+		return (storage)(((__int128)a * b + ((int64_t)1 << (shift - 1))) >> shift);
+	}
+	//division by zero saturates, as the floating kernels run to infinity, with headroom for the slack
+	static constexpr storage divide(storage a, storage b) {
+		return b != 0 ? (storage)((__int128)a * ((int64_t)1 << shift) / b) : (a < 0 ? INT64_MIN >> 2 : INT64_MAX >> 2);
+	}
+	static constexpr storage scale(storage a, double factor) {
+		return fromDouble(toDouble(a) * factor);
+	}
+	static constexpr storage shrink(storage a, double factor) {
+		return fromDouble(toDouble(a) / factor);
+	}
+	static storage sqrt(storage a) {
+		return fromDouble(std::sqrt(toDouble(a)));
+	}
+
+	//twice the signed area of a, b, c, formed exactly in 128 bits
+	static double orient2d(storage ax, storage ay, storage bx, storage by, storage cx, storage cy) {
+		__int128 const det = (__int128)(ax - cx) * (by - cy) - (__int128)(ay - cy) * (bx - cx);
+		return (double)det * resolution() * resolution();
+	}
+
+	static constexpr bool equal(storage a, storage b) {
+		return (a + slack > b && a - slack < b);
+	}
+	static constexpr bool notEqual(storage a, storage b) {
+		return (a + slack < b || a - slack > b);
+	}
+	static constexpr bool greater(storage a, storage b) {
+		return a - slack > b;
+	}
+	static constexpr bool less(storage a, storage b) {
+		return a + slack < b;
+	}
+	static constexpr bool greaterEqual(storage a, storage b) {
+		return a + slack > b;
+	}
+	static constexpr bool lessEqual(storage a, storage b) {
+		return a - slack < b;
+	}
+};
+
+#endif
+
+#if defined(GRID_KERNEL_LATTICE)
+#if !defined(__SIZEOF_INT128__)
+#error "GRID_KERNEL_LATTICE requires a compiler with 128 bit integers"
+#endif
+typedef lattice_kernel grid_kernel;
+#elif defined(GRID_KERNEL_FLOAT)
+typedef float_kernel grid_kernel;
+#else
+typedef double_kernel grid_kernel;
+#endif
@@ -0,0 +1,30 @@
+#include "Grid_Log.h"
+#include <cstdarg>
+#include <cstdio>
+
+namespace
+{
+	grid_log_sink active_sink = nullptr;
+}
+
+void setGridLogSink(grid_log_sink sink) {
+	active_sink = sink;
+}
+
+grid_log_sink getGridLogSink() {
+	return active_sink;
+}
+
+void gridLog(char const * format, ...) {
+	if (active_sink == nullptr)
+		return;
+
+	char buffer[512];
+
+	va_list args;
+	va_start(args, format);
+	vsnprintf(buffer, sizeof(buffer), format, args);
+	va_end(args);
+
+	active_sink(buffer);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+/*
+
+Contains the logging hook used by the geometry core
+messages are formatted printf style and handed to whichever sink is installed
+with no sink installed, messages are discarded
+
+*/
+
+typedef void(*grid_log_sink)(char const * message);
+
+//installs the sink that receives all formatted messages, nullptr silences logging
+void setGridLogSink(grid_log_sink sink);
+
+grid_log_sink getGridLogSink();
+
+//formats a message and passes it to the installed sink
+void gridLog(char const * format, ...);
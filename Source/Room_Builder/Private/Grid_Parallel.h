@@ -0,0 +1,55 @@
+#pragma once
+#include <thread>
+
+/*
+
+Contains a fork join helper for work split over independent items
+
+items are split into contiguous chunks, one per worker, and each item must only write to its own results,
+so the outcome never depends on scheduling
+small batches run inline on the calling thread
+
+*/
+
+//calls body(index) for every index in [0, count), spread over the hardware threads
+//each worker is given at least per_worker items, so small batches are not worth a thread
+template <class _F>
+void parallelFor(int count, int per_worker, _F const & body) {
+	if (per_worker < 1)
+		per_worker = 1;
+
+	//asking for the thread count is a system call, small batches skip it
+	int workers = count / per_worker;
+	if (workers > 1) {
+		int const hardware = (int)std::thread::hardware_concurrency();
+		if (workers > hardware)
+			workers = hardware;
+	}
+
+	if (workers <= 1) {
+		for (int index = 0; index < count; index++)
+			body(index);
+		return;
+	}
+
+	auto run = [&](int worker) {
+		int const first = (int)((long long)count * worker / workers);
+		int const last = (int)((long long)count * (worker + 1) / workers);
+
+		for (int index = first; index < last; index++)
+			body(index);
+	};
+
+	//the calling thread takes the first chunk
+	std::thread * helpers = new std::thread[workers - 1];
+
+	for (int worker = 1; worker < workers; worker++)
+		helpers[worker - 1] = std::thread(run, worker);
+
+	run(0);
+
+	for (int worker = 1; worker < workers; worker++)
+		helpers[worker - 1].join();
+
+	delete[] helpers;
+}
@@ -1,130 +1,5 @@
 #include "Grid_Point.h"
 
-Pgrd::Pgrd() {
-	X = 0;
-	Y = 0;
-}
-Pgrd::Pgrd(grd x, grd y) {
-	X = x;
-	Y = y;
-}
-
-Pgrd Pgrd::operator+(const Pgrd &target) const {
-	return Pgrd(X + target.X, Y + target.Y);
-}
-Pgrd Pgrd::operator-(const Pgrd &target) const {
-	return Pgrd(X - target.X, Y - target.Y);
-}
-Pgrd Pgrd::operator*(double factor) const
-{
-	return Pgrd(X * factor, Y * factor);
-}
-Pgrd Pgrd::operator*(grd factor) const {
-	return Pgrd(X * factor, Y * factor);
-}
-Pgrd Pgrd::operator*(const Pgrd &target) const {
-	return Pgrd(X * target.X, Y * target.Y);
-}
-Pgrd Pgrd::operator/(double factor) const
-{
-	return Pgrd(X / factor, Y / factor);
-}
-Pgrd Pgrd::operator/(grd factor) const {
-	return Pgrd(X / factor, Y / factor);
-}
-Pgrd Pgrd::operator/(const Pgrd &target) const {
-	return Pgrd(X / target.X, Y / target.Y);
-}
-
-Pgrd& Pgrd::operator+=(const Pgrd &target) {
-	X += target.X;
-	Y += target.Y;
-	return *this;
-}
-Pgrd& Pgrd::operator-=(const Pgrd &target) {
-	X -= target.X;
-	Y -= target.Y;
-	return *this;
-}
-Pgrd & Pgrd::operator*=(double factor)
-{
-	X *= factor;
-	Y *= factor;
-
-	return *this;
-}
-Pgrd& Pgrd::operator*=(grd factor) {
-	X *= factor;
-	Y *= factor;
-
-	return *this;
-}
-Pgrd& Pgrd::operator*=(const Pgrd &target) {
-	X *= target.X;
-	Y *= target.Y;
-	return *this;
-}
-Pgrd & Pgrd::operator/=(double factor)
-{
-	X /= factor;
-	Y /= factor;
-
-	return *this;
-}
-Pgrd& Pgrd::operator/=(grd factor) {
-	//check(X % div == 0);
-	//check(Y % div == 0);
-	X /= factor;
-	Y /= factor;
-	return *this;
-}
-Pgrd& Pgrd::operator/=(const Pgrd &target) {
-	//check(X % div.X == 0);
-	//check(Y % div.Y == 0);
-	X /= target.X;
-	Y /= target.Y;
-	return *this;
-}
-
-bool Pgrd::operator==(const Pgrd &test) const {
-	return test.X == X && test.Y == Y;
-}
-bool Pgrd::operator!=(const Pgrd &test) const {
-	return test.X != X || test.Y != Y;
-}
-grd Pgrd::SizeSquared() const {
-	return X * X + Y * Y;
-}
-grd Pgrd::Size() const {
-	return SizeSquared().sqrt();
-}
-
-void Pgrd::Normalize() {
-	grd const size = Size();
-	if (size == 0) {
-		return;
-	}
-
-	X /= size;
-	Y /= size;
-}
-
-grd Pgrd::Dot(const Pgrd &b) const {
-	return X * b.X + Y * b.Y;
-}
-
-Pgrd Pgrd::projectToSegment(Pgrd const & A, Pgrd const & B) const
-{
-	Pgrd const segment = B - A;
-	Pgrd const perp(-segment.Y, segment.X);
-
-	Pgrd result;
-
-	Pgrd::getIntersect(A, B, *this, *this + perp, result);
-
-	return result;
-}
-
 point_near_segment_state Pgrd::getState(const Pgrd &start, const Pgrd &end) const {
 	if (*this == start) {
 		return on_start;
@@ -133,11 +8,11 @@ point_near_segment_state Pgrd::getState(const Pgrd &start, const Pgrd &end) cons
 		return on_end;
 	}
 
-	const grd TWAT = (X * start.Y - Y * start.X) + (start.X * end.Y - start.Y * end.X) + (end.X * Y - end.Y * X);
-	if (TWAT > 0) {
+	orientation_state const side = orientation(start, end, *this);
+	if (side == orient_left) {
 		return left_of_segment;
 	}
-	if (TWAT < 0) {
+	if (side == orient_right) {
 		return right_of_segment;
 	}
 
@@ -156,11 +31,12 @@ bool Pgrd::areParrallel(const Pgrd &A_S, const Pgrd &A_E, const Pgrd &B_S, const
 	const auto A = A_E - A_S;
 	const auto B = B_E - B_S;
 
-	const auto D = A_S - B_S;
-
-	const auto denom = A.X * B.Y - A.Y * B.X;
+	//parallel when the shorter segment strays at most grid_epsilon from the direction of the longer,
+	//the same height tolerance orientation applies
+	const double cross = A.X.value() * B.Y.value() - A.Y.value() * B.X.value();
+	const double longest_squared = std::fmax(A.SizeSquared().value(), B.SizeSquared().value());
 
-	return denom == 0;
+	return cross * cross <= grid_epsilon * grid_epsilon * longest_squared;
 }
 
 bool Pgrd::isOnSegment(const Pgrd &test, const Pgrd &a, const Pgrd &b) {
@@ -172,7 +48,7 @@ bool Pgrd::inRegionCW(const Pgrd &test, const Pgrd &before, const Pgrd &corner,
 	return (test.getState(before, corner) == right_of_segment && test.getState(corner, after) == right_of_segment);
 }
 
-bool Pgrd::getIntersect(const Pgrd &A_S, const Pgrd &A_E, const Pgrd &B_S, const Pgrd &B_E, Pgrd &Result) {
+Pgrd Pgrd::getLineIntersect(const Pgrd &A_S, const Pgrd &A_E, const Pgrd &B_S, const Pgrd &B_E) {
 	const auto A = A_E - A_S;
 	const auto B = B_E - B_S;
 
@@ -180,38 +56,28 @@ bool Pgrd::getIntersect(const Pgrd &A_S, const Pgrd &A_E, const Pgrd &B_S, const
 
 	const auto denom = A.X * B.Y - A.Y * B.X;
 
-	if (denom == 0) { //REFACTOR
-		return false;
-	}
-
-	const auto s = (A.X * D.Y - A.Y * D.X) / denom;
 	const auto t = (B.X * D.Y - B.Y * D.X) / denom;
 
-	Result = (A * t) + A_S;
-
-	return (s >= 0 && s <= 1 && t >= 0 && t <= 1);
+	return (A * t) + A_S;
 }
 
-grd Pgrd::area(FLL<Pgrd> const & boundary) {
-	grd total = 0;
-
-	Pgrd A = boundary.last();
-
-	for (auto B : boundary) {
+bool Pgrd::getIntersect(const Pgrd &A_S, const Pgrd &A_E, const Pgrd &B_S, const Pgrd &B_E, Pgrd &Result) {
+	if (areParrallel(A_S, A_E, B_S, B_E)) {
+		return false;
+	}
 
-		grd width = B.X - A.X;
-		grd avg_height = (A.Y + B.Y) / 2;
+	Result = getLineIntersect(A_S, A_E, B_S, B_E);
 
-		total += width * avg_height;
+	//whether they cross is decided by orientation, so it agrees with getState
+	const orientation_state B_S_side = orientation(A_S, A_E, B_S);
+	const orientation_state B_E_side = orientation(A_S, A_E, B_E);
 
-		A = B;
+	if (B_S_side == B_E_side && B_S_side != orient_collinear) {
+		return false;
 	}
 
-	return total;
-}
-
-grd linear_offset(Pgrd const &A, Pgrd const &B) {
+	const orientation_state A_S_side = orientation(B_S, B_E, A_S);
+	const orientation_state A_E_side = orientation(B_S, B_E, A_E);
 
-	grd const top = (A.Y * B.X) - (A.X * B.Y);
-	return top / A.Size();
+	return !(A_S_side == A_E_side && A_S_side != orient_collinear);
 }
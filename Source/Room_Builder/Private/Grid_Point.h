@@ -1,6 +1,9 @@
 #pragma once
 #include "Grid.h"
 #include "FLL.h"
+#include "SVL.h"
+#include <cmath>
+#include <type_traits>
 
 /*
 
@@ -12,45 +15,109 @@ DCEL_region requires this representation as currently.
 
 enum point_near_segment_state { left_of_segment, right_of_segment, before_segment, after_segment, on_start, on_end, on_segment };
 enum intersect_state { no_intersect, at_start_of_a, at_start_of_b, };
+enum orientation_state { orient_right, orient_collinear, orient_left };
 
 
 struct Pgrd {
 	grd X;
 	grd Y;
 
-	Pgrd();
-	Pgrd(grd x, grd y);
-	//Pgrd(Pgrd &&target);
-	//Pgrd(Pgrd const &target);
-	//Pgrd & operator=(Pgrd const & target);
+	constexpr Pgrd() {}
+	constexpr Pgrd(grd x, grd y) : X(x), Y(y) {}
 
-	Pgrd operator+(const Pgrd &target) const;
-	Pgrd operator-(const Pgrd &target) const;
-	Pgrd operator*(double factor) const;
-	Pgrd operator*(grd factor) const;
-	Pgrd operator*(const Pgrd &target) const;
-	Pgrd operator/(double factor) const;
-	Pgrd operator/(grd factor) const;
-	Pgrd operator/(const Pgrd &target) const;
+	constexpr Pgrd operator+(const Pgrd &target) const {
+		return Pgrd(X + target.X, Y + target.Y);
+	}
+	constexpr Pgrd operator-(const Pgrd &target) const {
+		return Pgrd(X - target.X, Y - target.Y);
+	}
+	constexpr Pgrd operator*(double factor) const {
+		return Pgrd(X * factor, Y * factor);
+	}
+	constexpr Pgrd operator*(grd factor) const {
+		return Pgrd(X * factor, Y * factor);
+	}
+	constexpr Pgrd operator*(const Pgrd &target) const {
+		return Pgrd(X * target.X, Y * target.Y);
+	}
+	constexpr Pgrd operator/(double factor) const {
+		return Pgrd(X / factor, Y / factor);
+	}
+	constexpr Pgrd operator/(grd factor) const {
+		return Pgrd(X / factor, Y / factor);
+	}
+	constexpr Pgrd operator/(const Pgrd &target) const {
+		return Pgrd(X / target.X, Y / target.Y);
+	}
 
-	Pgrd& operator+=(const Pgrd &target);
-	Pgrd& operator-=(const Pgrd &target);
-	Pgrd& operator*=(double factor);
-	Pgrd& operator*=(grd factor);
-	Pgrd& operator*=(const Pgrd &target);
-	Pgrd& operator/=(double factor);
-	Pgrd& operator/=(grd factor);
-	Pgrd& operator/=(const Pgrd &target);
+	Pgrd& operator+=(const Pgrd &target) {
+		X += target.X;
+		Y += target.Y;
+		return *this;
+	}
+	Pgrd& operator-=(const Pgrd &target) {
+		X -= target.X;
+		Y -= target.Y;
+		return *this;
+	}
+	Pgrd& operator*=(double factor) {
+		X *= factor;
+		Y *= factor;
+		return *this;
+	}
+	Pgrd& operator*=(grd factor) {
+		X *= factor;
+		Y *= factor;
+		return *this;
+	}
+	Pgrd& operator*=(const Pgrd &target) {
+		X *= target.X;
+		Y *= target.Y;
+		return *this;
+	}
+	Pgrd& operator/=(double factor) {
+		X /= factor;
+		Y /= factor;
+		return *this;
+	}
+	Pgrd& operator/=(grd factor) {
+		X /= factor;
+		Y /= factor;
+		return *this;
+	}
+	Pgrd& operator/=(const Pgrd &target) {
+		X /= target.X;
+		Y /= target.Y;
+		return *this;
+	}
 
-	bool operator==(const Pgrd &test) const;
-	bool operator!=(const Pgrd &test) const;
+	constexpr bool operator==(const Pgrd &test) const {
+		return test.X == X && test.Y == Y;
+	}
+	constexpr bool operator!=(const Pgrd &test) const {
+		return test.X != X || test.Y != Y;
+	}
+
+	constexpr grd SizeSquared() const {
+		return X * X + Y * Y;
+	}
+	grd Size() const {
+		return SizeSquared().sqrt();
+	}
 
-	grd SizeSquared() const;
-	grd Size() const;
+	void Normalize() {
+		grd const size = Size();
+		if (size == 0) {
+			return;
+		}
 
-	void Normalize();
+		X /= size;
+		Y /= size;
+	}
 
-	grd Dot(const Pgrd &b) const;
+	constexpr grd Dot(const Pgrd &b) const {
+		return X * b.X + Y * b.Y;
+	}
 
 	Pgrd projectToSegment(Pgrd const &A, Pgrd const &B) const;
 
@@ -64,9 +131,41 @@ struct Pgrd {
 
 	static bool getIntersect(const Pgrd &A_S, const Pgrd &A_E, const Pgrd &B_S, const Pgrd &B_E, Pgrd &Result);
 
-	static grd area(FLL<Pgrd> const &boundary);
+	//where the line through A meets the line through B, the lines must not be parallel
+	static Pgrd getLineIntersect(const Pgrd &A_S, const Pgrd &A_E, const Pgrd &B_S, const Pgrd &B_E);
+
+	//signed area of a closed loop, accepts any forward range of points (lists, or DCEL loop ranges)
+	template <class _L>
+	static grd area(_L const &boundary);
 };
 
+template <class _L>
+grd Pgrd::area(_L const &boundary) {
+	grd total = 0;
+
+	auto const end = boundary.end();
+	if (boundary.begin() == end)
+		return total;
+
+	//walk to the last point first, the sum starts from the closing edge
+	Pgrd A;
+	for (auto focus = boundary.begin(); focus != end; ++focus)
+		A = *focus;
+
+	for (auto focus = boundary.begin(); focus != end; ++focus) {
+		Pgrd const & B = *focus;
+
+		grd width = B.X - A.X;
+		grd avg_height = (A.Y + B.Y) / 2;
+
+		total += width * avg_height;
+
+		A = B;
+	}
+
+	return total;
+}
+
 struct PBox {
 	Pgrd Min;
 	Pgrd Max;
@@ -79,4 +178,38 @@ struct PBox {
 	}
 };
 
-grd linear_offset(Pgrd const &A, Pgrd const &B);
\ No newline at end of file
+//coordinates are copied freely through the DCEL and the containers, keep them plain values
+static_assert(std::is_trivially_copyable<grd>::value, "grd must be trivially copyable");
+static_assert(std::is_trivially_copyable<Pgrd>::value, "Pgrd must be trivially copyable");
+
+//twice the signed area of the triangle a, b, c, positive when c lies left of a to b
+//the sign is always exact, see the kernel for how it is evaluated
+inline double orient2d(Pgrd const &a, Pgrd const &b, Pgrd const &c) {
+	return grid_kernel::orient2d(a.X.n, a.Y.n, b.X.n, b.Y.n, c.X.n, c.Y.n);
+}
+
+//the orientation of the triangle a, b, c with a tolerance on its height
+//the triangle is collinear when its smallest height is within grid_epsilon, which does not
+//depend on the order of the points or their scale, otherwise the exact sign of orient2d is used
+inline orientation_state orientation(Pgrd const &a, Pgrd const &b, Pgrd const &c) {
+	double const det = orient2d(a, b, c);
+
+	//the smallest height is the one over the longest side, |det| / longest, compared squared
+	double const longest_squared = std::fmax((b - a).SizeSquared().value(),
+		std::fmax((c - b).SizeSquared().value(), (a - c).SizeSquared().value()));
+
+	if (det * det <= grid_epsilon * grid_epsilon * longest_squared)
+		return orient_collinear;
+
+	return det > 0 ? orient_left : orient_right;
+}
+
+inline grd linear_offset(Pgrd const &A, Pgrd const &B) {
+	grd const top = (A.Y * B.X) - (A.X * B.Y);
+	return top / A.Size();
+}
+//as above, with the size of A already known
+inline grd linear_offset(Pgrd const &A, grd const &A_size, Pgrd const &B) {
+	grd const top = (A.Y * B.X) - (A.X * B.Y);
+	return top / A_size;
+}
\ No newline at end of file
@@ -1,24 +1,44 @@
 #include "Grid_Region.h"
+#include "Grid_Batch.h"
+#include "Grid_Index.h"
+#include "Grid_Log.h"
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 //#define debug_suballocate
 //#define debug_merge
 //#define debug_clean
 
-#if defined(debug_suballocate) || defined(debug_merge) || defined(debug_clean)
-#define using_unreal
-#endif
 
-#ifdef using_unreal
-#include "CoreMinimal.h"
-#endif
+bool inBounds(Face<Pgrd> const & rel, Pgrd const & test_point) {
+	Pgrd const & box_min = rel.getBoxMin();
+	Pgrd const & box_max = rel.getBoxMax();
 
+	double const extent = std::fmax(box_max.X.value() - box_min.X.value(), box_max.Y.value() - box_min.Y.value());
+	double const margin = 2 * grid_epsilon * (extent + 1);
+
+	return test_point.X.value() >= box_min.X.value() - margin && test_point.X.value() <= box_max.X.value() + margin &&
+		test_point.Y.value() >= box_min.Y.value() - margin && test_point.Y.value() <= box_max.Y.value() + margin;
+}
 
 FaceRelation const getPointRelation(Face<Pgrd> & rel, Pgrd const &test_point) {
 
 	Edge<Pgrd> * focus = rel.getRoot();
 
-	bool inside = Pgrd::area(rel.getLoopPoints()) < 0;
+	//orientation and bounds are cached on the face
+	bool inside = rel.getArea() < 0;
+
+	//a point clearly outside the bounds sits on no edge, and is inside only if the loop is inverted
+	//the margin covers the tolerance the crossing test below applies to its ratios
+	if (!inBounds(rel, test_point)) {
+		if (inside) {
+			return FaceRelation(FaceRelationType::point_interior, nullptr);
+		}
+		else {
+			return FaceRelation(FaceRelationType::point_exterior, nullptr);
+		}
+	}
 
 	do {
 		const Pgrd &start_vector = focus->getStart()->getPosition();
@@ -168,6 +188,68 @@ void cleanFace(Face<Pgrd> * target) {
 	} while (edge != target->getRoot());
 }
 
+bool symmetricContainment(Face<Pgrd> & a, Face<Pgrd> & b) {
+	Pgrd const & a_root = a.getRoot()->getStart()->getPosition();
+	Pgrd const & b_root = b.getRoot()->getStart()->getPosition();
+
+	bool const a_inverted = a.getArea() < 0;
+	bool const b_inverted = b.getArea() < 0;
+
+	//two outer loops would each have to lie within the other
+	if (!a_inverted && !b_inverted)
+		return false;
+
+	auto holds = [](Face<Pgrd> & rel, Pgrd const & test_point) {
+		return getPointRelation(rel, test_point).type == FaceRelationType::point_interior;
+	};
+
+	//a hole whose root lies within an outer loop lies entirely within it, so the outer root is outside the hole
+	if (!a_inverted)
+		return holds(a, b_root);
+	if (!b_inverted)
+		return holds(b, a_root);
+
+	//two holes hold each other unless one lies within the other, and only the smaller can lie within the larger
+	if (!inBounds(a, b_root) && !inBounds(b, a_root))
+		return true;
+
+	double const a_area = std::fabs(a.getArea().value());
+	double const b_area = std::fabs(b.getArea().value());
+
+	if (a_area < b_area)
+		return holds(b, a_root);
+	if (b_area < a_area)
+		return holds(a, b_root);
+
+	return holds(b, a_root) && holds(a, b_root);
+}
+
+bool completesContainment(Face<Pgrd> & a, Face<Pgrd> & b) {
+	bool const a_inverted = a.getArea() < 0;
+	bool const b_inverted = b.getArea() < 0;
+
+	if (!a_inverted && !b_inverted)
+		return false;
+
+	//a hole within an outer loop leaves the outer root outside it
+	if (!b_inverted)
+		return true;
+
+	Pgrd const & b_root = b.getRoot()->getStart()->getPosition();
+
+	if (!a_inverted)
+		return getPointRelation(a, b_root).type == FaceRelationType::point_interior;
+
+	//two holes apart hold each other, and the larger can not lie within the smaller
+	if (!inBounds(a, b_root) && !inBounds(b, a.getRoot()->getStart()->getPosition()))
+		return true;
+
+	if (std::fabs(a.getArea().value()) < std::fabs(b.getArea().value()))
+		return true;
+
+	return getPointRelation(a, b_root).type == FaceRelationType::point_interior;
+}
+
 //TODO: self cleaning merge
 bool merge(Region<Pgrd> * a, Region<Pgrd> * b) {
 	//since both areas are continuous, its trivial that only one or no boundary pair can touch
@@ -184,11 +266,19 @@ bool merge(Region<Pgrd> * a, Region<Pgrd> * b) {
 		Face<Pgrd> * target_face = nullptr;
 		for (auto focus_local : a->getBounds()) {
 
-			auto neighbors = focus_local->getNeighbors();
+			//stamp the neighbors of focus_local, so each test below is O(1)
+			unsigned const epoch = a->getUni()->beginTraversal();
+			{
+				Edge<Pgrd> const * focus = focus_local->getRoot();
+				do {
+					focus->getInv()->getFace()->visit(epoch);
+					focus = focus->getNext();
+				} while (focus != focus_local->getRoot());
+			}
 
 			for (auto focus_target : b->getBounds()) {
 
-				if (neighbors.contains(focus_target)) {
+				if (focus_target->visited(epoch)) {
 					local_face = focus_local;
 					target_face = focus_target;
 					break;
@@ -203,19 +293,19 @@ bool merge(Region<Pgrd> * a, Region<Pgrd> * b) {
 		if (local_face == nullptr) return false;
 
 #ifdef debug_merge
-		UE_LOG(LogTemp, Warning, TEXT("merging"));
-		UE_LOG(LogTemp, Warning, TEXT("a"));
+		gridLog("merging");
+		gridLog("a");
 		for (auto bound : a->getBounds()) {
-			UE_LOG(LogTemp, Warning, TEXT("face >k-"));
+			gridLog("face >k-");
 			for (auto point : bound->getLoopPoints()) {
-				UE_LOG(LogTemp, Warning, TEXT("(%f,%f)"), point.X.n, point.Y.n);
+				gridLog("(%f,%f)", point.X.value(), point.Y.value());
 			}
 		}
-		UE_LOG(LogTemp, Warning, TEXT("b"));
+		gridLog("b");
 		for (auto bound : b->getBounds()) {
-			UE_LOG(LogTemp, Warning, TEXT("face >b-"));
+			gridLog("face >b-");
 			for (auto point : bound->getLoopPoints()) {
-				UE_LOG(LogTemp, Warning, TEXT("(%f,%f)"), point.X.n, point.Y.n);
+				gridLog("(%f,%f)", point.X.value(), point.Y.value());
 			}
 		}
 #endif
@@ -237,11 +327,11 @@ bool merge(Region<Pgrd> * a, Region<Pgrd> * b) {
 		}
 
 #ifdef debug_merge
-		UE_LOG(LogTemp, Warning, TEXT("result"));
+		gridLog("result");
 		for (auto bound : a->getBounds()) {
-			UE_LOG(LogTemp, Warning, TEXT("face >r:"));
+			gridLog("face >r:");
 			for (auto point : bound->getLoopPoints()) {
-				UE_LOG(LogTemp, Warning, TEXT("(%f,%f)"), point.X.n, point.Y.n);
+				gridLog("(%f,%f)", point.X.value(), point.Y.value());
 			}
 		}
 #endif
@@ -250,11 +340,11 @@ bool merge(Region<Pgrd> * a, Region<Pgrd> * b) {
 	}
 	else {
 #ifdef debug_merge
-		UE_LOG(LogTemp, Warning, TEXT("merging"));
+		gridLog("merging");
 		for (auto bound : a->getBounds()) {
-			UE_LOG(LogTemp, Warning, TEXT("face >k:"));
+			gridLog("face >k:");
 			for (auto point : bound->getLoopPoints()) {
-				UE_LOG(LogTemp, Warning, TEXT("(%f,%f)"), point.X.n, point.Y.n);
+				gridLog("(%f,%f)", point.X.value(), point.Y.value());
 			}
 		}
 #endif
@@ -279,11 +369,11 @@ bool merge(Region<Pgrd> * a, Region<Pgrd> * b) {
 			++focus_local;
 		}
 #ifdef debug_merge
-		UE_LOG(LogTemp, Warning, TEXT("result"));
+		gridLog("result");
 		for (auto bound : a->getBounds()) {
-			UE_LOG(LogTemp, Warning, TEXT("face >r:"));
+			gridLog("face >r:");
 			for (auto point : bound->getLoopPoints()) {
-				UE_LOG(LogTemp, Warning, TEXT("(%f,%f)"), point.X.n, point.Y.n);
+				gridLog("(%f,%f)", point.X.value(), point.Y.value());
 			}
 		}
 #endif
@@ -293,6 +383,68 @@ bool merge(Region<Pgrd> * a, Region<Pgrd> * b) {
 
 }
 
+void mergeRegions(Region<Pgrd> * target, SVL<Region<Pgrd> *> const & sources) {
+	SVL<Face<Pgrd> *> faces;
+
+	for (auto face : target->getBounds())
+		faces.append(face);
+	for (auto source : sources)
+		for (auto face : source->getBounds())
+			faces.append(face);
+
+	//boundaries leave their regions first, faces destroyed below must not stay listed
+	target->clear();
+	for (auto source : sources)
+		source->clear();
+
+	unsigned const epoch = target->getUni()->beginTraversal();
+	for (auto face : faces)
+		face->visit(epoch);
+
+	//every edge with both sides among the boundaries, only one of each edge pair is removed
+	SVL<Edge<Pgrd> *> shared;
+	for (auto face : faces) {
+		Edge<Pgrd> * focus = face->getRoot();
+		do {
+			if (focus->getInv()->getFace()->visited(epoch) && !focus->getInv()->visited(epoch)) {
+				focus->visit(epoch);
+				shared.append(focus);
+			}
+
+			focus = focus->getNext();
+		} while (focus != face->getRoot());
+	}
+
+	//the faces a removal left or created, as merge collects from mergeWithFace
+	SVL<Face<Pgrd> *> merged;
+
+	for (auto edge : shared) {
+		Face<Pgrd> * const kept = edge->getFace();
+
+		EdgeModResult<Pgrd> result = edge->remove();
+
+		if (result.type == EdgeModType::face_created) {
+			faces.append(result.relevant);
+			merged.append(result.relevant);
+		}
+		else if (result.type == EdgeModType::face_destroyed) {
+			faces.remove(result.relevant);
+			merged.remove(result.relevant);
+		}
+
+		if (!(result.type == EdgeModType::face_destroyed && result.relevant == kept) && !merged.contains(kept))
+			merged.append(kept);
+	}
+
+	//joining separate regions leaves straight corners where the shared edges met, other faces are left as they are
+	for (auto face : faces) {
+		if (sources.size() > 0 && merged.contains(face))
+			cleanFace(face);
+
+		target->append(face);
+	}
+}
+
 struct intersect {
 
 	Pgrd location;
@@ -300,192 +452,259 @@ struct intersect {
 	grd distance;
 };
 
-bool intersectSort(intersect *a, intersect *b) {
-	return a->distance > b->distance;
-}
+//the intersects of one segment, held on the stack unless a segment crosses many edges
+typedef SVL<intersect, 16> Intersect_List;
 
-//returns a list of intersects sorted by distance
-FLL<intersect *> findIntersects(Pgrd const & start, Pgrd const & stop,
-	FLL<Edge<Pgrd> *> const & canidates) {
+//appends the intersects of the segment with canidates, sorted by distance
+//hits are gathered as found and sorted once, hits at equal distance keep the order they were found in
+void findIntersects(Pgrd const & start, Pgrd const & stop,
+	SVL<Edge<Pgrd> *> const & canidates, Intersect_List & product) {
 
-	//detect intersect
-	FLL<intersect *> product;
+	int const first = product.size();
 
-	for (auto target : canidates) {
+	auto hit = [&](Pgrd const & location, Edge<Pgrd> * mark, grd const & distance) {
+		intersect output;
 
-		Pgrd intersect_location;
+		output.location = location;
+		output.mark = mark;
+		output.distance = distance;
+
+		product.append(output);
+	};
+
+	//the batch settles clear misses and crossings, only edges touching the segment take the tests below
+	SVL<segment_test> tests;
+	getSegmentTests(start, stop, canidates, tests);
+
+	for (int index = 0; index < canidates.size(); index++) {
+		auto target = canidates[index];
+
+		if (tests[index].state == segment_apart)
+			continue;
 
 		Pgrd test_start = target->getStart()->getPosition();
 		Pgrd test_stop = target->getEnd()->getPosition();
 
-		bool valid = Pgrd::getIntersect(start, stop, test_start, test_stop, intersect_location);
+		if (tests[index].state == segment_crossing) {
+			Pgrd const location = Pgrd::getLineIntersect(start, stop, test_start, test_stop);
 
-		if (valid) {
-			intersect * output = new intersect();
+			hit(location, target, (location - start).SizeSquared());
+
+			continue;
+		}
 
-			output->location = intersect_location;
-			output->mark = target;
-			output->distance = (intersect_location - start).SizeSquared();
+		Pgrd intersect_location;
 
-			product.qInsert(output, intersectSort);
+		bool valid = Pgrd::getIntersect(start, stop, test_start, test_stop, intersect_location);
 
+		if (valid) {
+			hit(intersect_location, target, (intersect_location - start).SizeSquared());
 		}
 		else {
 			//parrallel test
-			Pgrd a = stop - start;
-			Pgrd b = test_stop - test_start;
-
-			grd x, y;
-			if (a.Y != 0 && b.Y != 0) {
-				x = a.X / a.Y;
-				y = b.X / b.Y;
-			}
-			else if (a.Y == 0 && b.Y == 0) {
-				x = a.X / a.X;
-				y = b.X / b.X;
-			}
-
-			if (x == y || x == -y) {
+			if (Pgrd::areParrallel(start, stop, test_start, test_stop)) {
 
 				//create an interesect for the ends of each segment, that lie on the other segment
 				if (Pgrd::isOnSegment(start, test_start, test_stop)) {
-					intersect * output = new intersect();
-
-					output->location = start;
-					output->mark = target;
-					output->distance = 0;
-
-					product.qInsert(output, intersectSort);
+					hit(start, target, 0);
 				}
 
 				if (Pgrd::isOnSegment(stop, test_start, test_stop)) {
-					intersect * output = new intersect();
-
-					output->location = stop;
-					output->mark = target;
-					output->distance = (stop - start).SizeSquared();
-
-					product.qInsert(output, intersectSort);
+					hit(stop, target, (stop - start).SizeSquared());
 				}
 
 				if (Pgrd::isOnSegment(test_start, start, stop) && test_start != start && test_start != stop) {
-					intersect * output = new intersect();
-
-					output->location = test_start;
-					output->mark = target;
-					output->distance = (test_start - start).SizeSquared();
-
-					product.qInsert(output, intersectSort);
+					hit(test_start, target, (test_start - start).SizeSquared());
 				}
 
 				if (Pgrd::isOnSegment(test_stop, start, stop) && test_stop != start && test_stop != stop) {
-					intersect * output = new intersect();
-
-					output->location = test_stop;
-					output->mark = target;
-					output->distance = (test_stop - start).SizeSquared();
-
-					product.qInsert(output, intersectSort);
+					hit(test_stop, target, (test_stop - start).SizeSquared());
 				}
 			}
 		}
 	}
 
+	std::stable_sort(product.data() + first, product.data() + product.size(), [](intersect const & a, intersect const & b) {
+		return a.distance < b.distance;
+	});
+}
 
-	return product;
+//a hit of one boundary segment on a region edge, found before any edge is subdivided
+struct boundary_hit {
+	Pgrd location;
+	//the region edge as it was before subdividing, and the piece of it ending at location after
+	Edge<Pgrd> * edge;
+	Edge<Pgrd> * piece;
+	//the squared distance from the start of edge, orders the split points along it
+	grd along;
+};
+
+//splits every hit edge once, at its sorted split points, and gives each hit the piece ending at its location
+//edges are ranked by their order in canidates, so edges are split in a fixed order
+//the ranks are kept by edge handle here, edge marks belong to the caller, and the new pieces are added to grid
+void splitHits(Region<Pgrd> * target, SVL<Edge<Pgrd> *> const & canidates, SVL<boundary_hit> & hits, Edge_Grid & grid) {
+	if (hits.size() == 0)
+		return;
+
+	DCEL<Pgrd> const * universe = target->getUni();
+
+	std::vector<int> ranks;
+	for (int index = 0; index < canidates.size(); index++) {
+		unsigned const handle = universe->getHandle(canidates[index]);
+		if (handle >= ranks.size())
+			ranks.resize(handle + 1, 0);
+		ranks[handle] = index + 1;
+	}
+
+	SVL<int> order;
+	SVL<int> edge_ranks;
+	for (int index = 0; index < hits.size(); index++) {
+		order.append(index);
+		edge_ranks.append(ranks[universe->getHandle(hits[index].edge)]);
+	}
+
+	std::stable_sort(order.data(), order.data() + order.size(), [&](int a, int b) {
+		if (edge_ranks[a] != edge_ranks[b])
+			return edge_ranks[a] < edge_ranks[b];
+		return hits[a].along < hits[b].along;
+	});
+
+	//each subdivision leaves the edge as the remainder past the split, so splits walk up the edge in order
+	Edge<Pgrd> * previous_edge = nullptr;
+	boundary_hit const * previous_hit = nullptr;
+
+	for (int index : order) {
+		boundary_hit & focus = hits[index];
+		Edge<Pgrd> * const edge = focus.edge;
+
+		if (edge == previous_edge && focus.location == previous_hit->location) {
+			focus.piece = previous_hit->piece;
+		}
+		else if (focus.location == edge->getEnd()->getPosition()) {
+			focus.piece = edge;
+		}
+		else {
+			edge->getInv()->subdivide(focus.location);
+			focus.piece = edge->getLast();
+
+			grid.append(focus.piece);
+		}
+
+		previous_edge = edge;
+		previous_hit = &focus;
+	}
 }
 
 //finds interact features for a suballocation, and subidivides region edges where needed
 //returns true if boundary is entirely external
-bool markRegion(Region<Pgrd> * target, FLL<Pgrd> const & boundary, FLL<interact *>  & details) {
+bool markRegion(Region<Pgrd> * target, FLL<Pgrd> const & boundary, Interact_List & details) {
 
 	bool exterior = true;
 
 	{
-		FLL<Edge<Pgrd> *> canidates;
+		SVL<Edge<Pgrd> *> canidates;
 
 		for (auto canidate_focus : target->getBounds()) {
-			auto tba = canidate_focus->getLoopEdges(); //TODO: rvalues
-			canidates.absorb(tba);
+			canidate_focus->getLoopEdges(canidates);
 		}
 
-		auto last = boundary.last();
-		for (auto next : boundary) {
-			//find and perform on all intersects
+		//every hit is found against the edges as they are, the edges are only split once all are known
+		//each boundary segment only tests the edges near it
+		SVL<boundary_hit> hits;
+		SVL<int> segment_hits;
+		SVL<Pgrd> segment_ends;
 
-			auto intersects = findIntersects(last, next, canidates);
-
-			bool end_collision = false;
+		//the pieces of split edges are added, so the grid goes on to serve the locator
+		Edge_Grid canidate_grid(canidates);
 
-			for (auto const & intersect_focus : intersects) {
+		{
+			SVL<Edge<Pgrd> *> nearby;
+			Intersect_List intersects;
 
-				auto mark = intersect_focus->mark;
+			auto last = boundary.last();
+			for (auto next : boundary) {
+				segment_hits.append(hits.size());
+				segment_ends.append(next);
 
-				//ignore hits at the start of either segment
-				if (intersect_focus->location != last && intersect_focus->location != mark->getStart()->getPosition()) {
+				nearby.clear();
+				canidate_grid.query(last, next, nearby);
 
+				intersects.clear();
+				findIntersects(last, next, nearby, intersects);
 
-					interact* feature = new interact();
+				for (auto const & intersect_focus : intersects) {
 
-					feature->location = intersect_focus->location;
-					feature->type = FaceRelationType::point_on_boundary;
+					auto mark = intersect_focus.mark;
 
+					//ignore hits at the start of either segment
+					if (intersect_focus.location != last && intersect_focus.location != mark->getStart()->getPosition()) {
+						boundary_hit hit;
 
-					if (intersect_focus->location == mark->getEnd()->getPosition()) {
-						//no need to subdivide
+						hit.location = intersect_focus.location;
+						hit.edge = mark;
+						hit.piece = nullptr;
+						hit.along = (intersect_focus.location - mark->getStart()->getPosition()).SizeSquared();
 
-						feature->mark = mark;
+						hits.append(hit);
 					}
-					else {
-						//subdivide mark
+				}
 
-						mark->getInv()->subdivide(intersect_focus->location);
+				last = next;
+			}
 
-						feature->mark = mark->getLast();
+			segment_hits.append(hits.size());
+		}
 
-						canidates.push(feature->mark);
-					}
+		splitHits(target, canidates, hits, canidate_grid);
 
-					if (intersect_focus->location == next) {
-						//prevents duplicate features for ends of segments
-						end_collision = true;
-					}
+		//the ends and mid points follow the boundary, so each is placed by walking from the one before
+		Region_Locator locator(target, &canidate_grid);
+		locate_hint hint;
+
+		//features follow the boundary, each segment's hits in order of distance then its end
+		for (int segment = 0; segment < segment_ends.size(); segment++) {
+			Pgrd const & next = segment_ends[segment];
+
+			bool end_collision = false;
 
-					exterior = false;
-					details.append(feature);
+			for (int index = segment_hits[segment]; index < segment_hits[segment + 1]; index++) {
+				interact feature;
+
+				feature.location = hits[index].location;
+				feature.type = FaceRelationType::point_on_boundary;
+				feature.mark = hits[index].piece;
+
+				if (hits[index].location == next) {
+					//prevents duplicate features for ends of segments
+					end_collision = true;
 				}
+
+				exterior = false;
+				details.append(feature);
 			}
 
 			if (!end_collision) {
 
-				auto state = contains(target, next);
+				FaceRelation const state = locator.locate(next, hint).relation;
 
+				interact feature;
 
-
-				interact* feature = new interact();
-
-				feature->location = next;
-				feature->type = state.type;
-				feature->mark = state.relevant;
+				feature.location = next;
+				feature.type = state.type;
+				feature.mark = state.relevant;
 
 				exterior = exterior && (state.type == FaceRelationType::point_exterior);
 				details.append(feature);
 			}
-
-			last = next;
 		}
-	}
-
-	//calculate mid inclusion
 
-	{
-		auto last = details.last();
-		for (auto next : details) {
-			last->mid_location = (last->location + next->location) / 2;
+		//calculate mid inclusion
 
-			auto result = contains(target, last->mid_location);
+		int last = details.size() - 1;
+		for (int next = 0; next < details.size(); next++) {
+			details[last].mid_location = (details[last].location + details[next].location) / 2;
 
-			last->mid_type = result.type;
+			details[last].mid_type = locator.locate(details[last].mid_location, hint).relation.type;
 
 			last = next;
 		}
@@ -519,20 +738,27 @@ bool between(Pgrd const &A, Pgrd const &B, Pgrd const &test) {
 }
 
 //insert strands into target, and determine face inclusions
-void determineInteriors(Region<Pgrd> * target, FLL<interact *> & details,
+void determineInteriors(Region<Pgrd> * target, Interact_List & details,
 	FLL<Face<Pgrd> *> & exteriors, FLL<Face<Pgrd> *> & interiors) {
 
-	exteriors = target->getBounds();
+	exteriors.clear();
+	for (auto face : target->getBounds())
+		exteriors.append(face);
+
+	//faces are stamped as they are added to interiors
+	unsigned const epoch = target->getUni()->beginTraversal();
 
-	auto last = details.begin();
-	auto next = last.cyclic_next();
+	int const count = details.size();
+
+	int last = 0;
+	int next = 1 % count;
 
 
 	//consider first segment, if entirely internal, we need to create an edge from scratch
-	if (last->type == FaceRelationType::point_interior) {
+	if (details[last].type == FaceRelationType::point_interior) {
 
-		auto into = *next;
-		auto from = *last;
+		interact * into = &details[next];
+		interact * from = &details[last];
 
 		if (into->type == FaceRelationType::point_interior) {
 
@@ -549,14 +775,14 @@ void determineInteriors(Region<Pgrd> * target, FLL<interact *> & details,
 
 		from->type = FaceRelationType::point_on_boundary;
 
-		++last;
+		last++;
 	}
 
-	while (last != details.end()) {
-		next = last.cyclic_next();
+	while (last < count) {
+		next = (last + 1) % count;
 
-		auto into = *next;
-		auto from = *last;
+		interact * into = &details[next];
+		interact * from = &details[last];
 
 		if (from->type != FaceRelationType::point_exterior) {
 			if (into->type == FaceRelationType::point_interior) {
@@ -581,18 +807,18 @@ void determineInteriors(Region<Pgrd> * target, FLL<interact *> & details,
 						if (between(next_vector, created_vector, orientation))
 							into->mark = created;
 
-						if (!interiors.contains(created->getFace()))
+						if (created->getFace()->visit(epoch))
 							interiors.push(created->getFace());
 
 						exteriors.push(created->getInv()->getFace());
 					}
-					else if (next == details.begin()) {
+					else if (next == 0) {
 						auto relevant = into->mark->getNext()->getInv();
 						exteriors.remove(relevant->getFace());
 
 						auto created = target->getUni()->addEdge(from->mark, relevant);
 
-						if (!interiors.contains(created->getFace()))
+						if (created->getFace()->visit(epoch))
 							interiors.push(created->getFace());
 
 						exteriors.push(created->getInv()->getFace());
@@ -607,12 +833,12 @@ void determineInteriors(Region<Pgrd> * target, FLL<interact *> & details,
 			}
 		}
 
-		++last;
+		last++;
 	}
 
 	//does the entire boundary lie on a loop
 	if (interiors.empty()) {
-		auto from = *details.begin();
+		interact * from = &details[0];
 
 
 		if (from->type == FaceRelationType::point_on_boundary) {
@@ -626,19 +852,19 @@ void determineInteriors(Region<Pgrd> * target, FLL<interact *> & details,
 }
 
 void subAllocate(Region<Pgrd> * target, FLL<Pgrd> const & boundary,
-	FLL<Region<Pgrd> *> & exteriors, FLL<Region<Pgrd> *> & interiors) {
+	SVL<Region<Pgrd> *> & exteriors, SVL<Region<Pgrd> *> & interiors) {
 
 #ifdef debug_suballocate
-	UE_LOG(LogTemp, Warning, TEXT("SA"));
-	UE_LOG(LogTemp, Warning, TEXT("Boundary >g:"));
+	gridLog("SA");
+	gridLog("Boundary >g:");
 	for (auto point : boundary) {
-		UE_LOG(LogTemp, Warning, TEXT("(%f,%f)"), point.X.n, point.Y.n);
+		gridLog("(%f,%f)", point.X.value(), point.Y.value());
 	}
 
 	for (auto face : target->getBounds()) {
-		UE_LOG(LogTemp, Warning, TEXT("Face >k-"));
+		gridLog("Face >k-");
 		for (auto point : face->getLoopPoints()) {
-			UE_LOG(LogTemp, Warning, TEXT("(%f,%f)"), point.X.n, point.Y.n);
+			gridLog("(%f,%f)", point.X.value(), point.Y.value());
 		}
 	}
 #endif
@@ -649,7 +875,7 @@ void subAllocate(Region<Pgrd> * target, FLL<Pgrd> const & boundary,
 	//interior
 	//subdivides are performed on inverse to preserve marks
 
-	FLL<interact *> details;
+	Interact_List details;
 
 	bool exterior = markRegion(target, boundary, details);
 
@@ -657,15 +883,15 @@ void subAllocate(Region<Pgrd> * target, FLL<Pgrd> const & boundary,
 	FLL<Face<Pgrd> *> interior_faces;
 
 #ifdef debug_suballocate
-	for (auto detail : details) {
-		if (detail->type == FaceRelationType::point_exterior) {
-			UE_LOG(LogTemp, Warning, TEXT("(%f,%f) : exterior"), detail->location.X.n, detail->location.Y.n);
+	for (auto const & detail : details) {
+		if (detail.type == FaceRelationType::point_exterior) {
+			gridLog("(%f,%f) : exterior", detail.location.X.value(), detail.location.Y.value());
 		}
-		else if (detail->type == FaceRelationType::point_interior) {
-			UE_LOG(LogTemp, Warning, TEXT("(%f,%f) : interior"), detail->location.X.n, detail->location.Y.n);
+		else if (detail.type == FaceRelationType::point_interior) {
+			gridLog("(%f,%f) : interior", detail.location.X.value(), detail.location.Y.value());
 		}
 		else {
-			UE_LOG(LogTemp, Warning, TEXT("(%f,%f) : bound"), detail->location.X.n, detail->location.Y.n);
+			gridLog("(%f,%f) : bound", detail.location.X.value(), detail.location.Y.value());
 		}
 
 	}
@@ -695,57 +921,78 @@ void subAllocate(Region<Pgrd> * target, FLL<Pgrd> const & boundary,
 		//determine exterior face sets with universal containment, create regions out of these\
 
 		//for each interior face, create a region, add any symmetricly contained exterior faces to that region
-		for (auto interior_face : interior_faces) {
-			Region<Pgrd> * novel = target->getUni()->region();
+		//containment is looked up through an index over the exterior faces, a face's order is its place in the list
+		//the roots are placed in one batch, and the faces holding a root need at most one point test in turn
+		Face_Index exterior_index(exterior_faces);
 
-			auto interior_root = interior_face->getRoot()->getStart()->getPosition();
+		SVL<bool> taken;
+		for (int order = 0; order < exterior_index.size(); order++)
+			taken.append(false);
 
-			getPointRelation(*interior_face, interior_root);
+		SVL<Pgrd> interior_roots;
+		for (auto interior_face : interior_faces)
+			interior_roots.append(interior_face->getRoot()->getStart()->getPosition());
 
-			for (auto exterior_focus = exterior_faces.begin(); exterior_focus != exterior_faces.end();) {
+		SVL<int> offsets;
+		SVL<int> containers;
+		exterior_index.containing(interior_roots, offsets, containers);
 
-				auto exterior_face = *exterior_focus;
-				auto exterior_root = exterior_face->getRoot()->getStart()->getPosition();
+		int interior_order = 0;
+		for (auto interior_face : interior_faces) {
+			Region<Pgrd> * novel = target->getUni()->region();
 
-				auto ex_contains_in = getPointRelation(*exterior_face, interior_root);
-				auto in_contains_ex = getPointRelation(*interior_face, exterior_root);
+			for (int index = offsets[interior_order]; index < offsets[interior_order + 1]; index++) {
+				int const order = containers[index];
 
-				++exterior_focus;
+				if (taken[order])
+					continue;
 
-				if (ex_contains_in.type == FaceRelationType::point_interior && in_contains_ex.type == FaceRelationType::point_interior) {
+				auto exterior_face = exterior_index[order];
+
+				if (completesContainment(*interior_face, *exterior_face)) {
 					novel->append(exterior_face);
 
-					exterior_faces.remove(exterior_face);
+					taken[order] = true;
 				}
 			}
 
 			novel->append(interior_face);
 
 			interiors.push(novel);
+
+			interior_order++;
 		}
 
-		//for each exterior face, see which faces are symmetric with it and create regions
+		//for each exterior face, see which later faces are symmetric with it and create regions
 
-		for (auto exterior_focus = exterior_faces.begin(); exterior_focus != exterior_faces.end(); ++exterior_focus) {
-			Region<Pgrd> * novel = target->getUni()->region();
+		SVL<Pgrd> exterior_roots;
+		for (int order = 0; order < exterior_index.size(); order++)
+			exterior_roots.append(exterior_index[order]->getRoot()->getStart()->getPosition());
 
-			auto base_face = *exterior_focus;
-			auto base_root = base_face->getRoot()->getStart()->getPosition();
+		offsets.clear();
+		containers.clear();
+		exterior_index.containing(exterior_roots, offsets, containers);
 
-			for (auto compare = exterior_focus.next(); compare != exterior_faces.end();) {
+		for (int base = 0; base < exterior_index.size(); base++) {
+			if (taken[base])
+				continue;
 
-				auto comp_face = *compare;
-				auto comp_root = comp_face->getRoot()->getStart()->getPosition();
+			Region<Pgrd> * novel = target->getUni()->region();
+
+			auto base_face = exterior_index[base];
 
-				auto comp_contains_base = getPointRelation(*comp_face, base_root);
-				auto base_contains_comp = getPointRelation(*base_face, comp_root);
+			for (int index = offsets[base]; index < offsets[base + 1]; index++) {
+				int const order = containers[index];
 
-				++compare;
+				if (order <= base || taken[order])
+					continue;
 
-				if (comp_contains_base.type == FaceRelationType::point_interior && base_contains_comp.type == FaceRelationType::point_interior) {
+				auto comp_face = exterior_index[order];
+
+				if (completesContainment(*base_face, *comp_face)) {
 					novel->append(comp_face);
 
-					exterior_faces.remove(comp_face);
+					taken[order] = true;
 				}
 			}
 
@@ -761,16 +1008,16 @@ void subAllocate(Region<Pgrd> * target, FLL<Pgrd> const & boundary,
 void cleanRegion(Region<Pgrd> * target) {
 
 #ifdef debug_clean
-	UE_LOG(LogTemp, Warning, TEXT("Clean Region"));
+	gridLog("Clean Region");
 #endif
 	for (auto border : target->getBounds()) {
 		auto og_root = border->getRoot();
 		auto focus = og_root;
 
 #ifdef debug_clean
-		UE_LOG(LogTemp, Warning, TEXT("Face >k:"));
+		gridLog("Face >k:");
 		for (auto point : border->getLoopPoints()) {
-			UE_LOG(LogTemp, Warning, TEXT("(%f,%f)"), point.X.n, point.Y.n);
+			gridLog("(%f,%f)", point.X.value(), point.Y.value());
 		}
 #endif
 
@@ -780,34 +1027,21 @@ void cleanRegion(Region<Pgrd> * target) {
 			// mid point degree is two test
 			if (focus->getInv()->getLast() == next->getInv()) {
 
-				bool parallel = false;
-
-				// parallel test
+				// parallel test, the shared point lies in line with its neighbors
+				Pgrd const & start = focus->getStart()->getPosition();
+				Pgrd const & mid = focus->getEnd()->getPosition();
+				Pgrd const & end = next->getEnd()->getPosition();
 
-				Pgrd const start = focus->getStart()->getPosition();
-				Pgrd const mid = focus->getEnd()->getPosition();
-				Pgrd const end = next->getEnd()->getPosition();
-
-				Pgrd const a = mid - start;
-				Pgrd const b = end - mid;
-
-				if (a.Y != 0 && b.Y != 0) {
-					grd x = a.X / a.Y;
-					grd y = b.X / b.Y;
-					parallel = x == y;
-				}
-				else if (a.Y == 0 && b.Y == 0) {
-					parallel = true;
-				}
+				bool const parallel = orientation(start, mid, end) == orient_collinear;
 
 				if (parallel) {
 #ifdef debug_clean
-					UE_LOG(LogTemp, Warning, TEXT("contract >r:"));
-					UE_LOG(LogTemp, Warning, TEXT("(%f,%f)"), start.X.n, start.Y.n);
-					UE_LOG(LogTemp, Warning, TEXT("(%f,%f)"), mid.X.n, mid.Y.n);
-					UE_LOG(LogTemp, Warning, TEXT("contract >g:"));
-					UE_LOG(LogTemp, Warning, TEXT("(%f,%f)"), mid.X.n, mid.Y.n);
-					UE_LOG(LogTemp, Warning, TEXT("(%f,%f)"), end.X.n, end.Y.n);
+					gridLog("contract >r:");
+					gridLog("(%f,%f)", start.X.value(), start.Y.value());
+					gridLog("(%f,%f)", mid.X.value(), mid.Y.value());
+					gridLog("contract >g:");
+					gridLog("(%f,%f)", mid.X.value(), mid.Y.value());
+					gridLog("(%f,%f)", end.X.value(), end.Y.value());
 #endif
 					next->getInv()->contract();
 				}
@@ -848,8 +1082,7 @@ Region<Pgrd> * RegionAdd(Region<Pgrd> * target, Edge<Pgrd> * A, Edge<Pgrd> * B)
 		for (auto edge : target->getBounds())
 			if (edge == A_face)
 				continue;
-			else if (getPointRelation(*edge, B_face->getRoot()->getStart()->getPosition()).type == FaceRelationType::point_interior
-				&& getPointRelation(*B_face, edge->getRoot()->getStart()->getPosition()).type == FaceRelationType::point_interior)
+			else if (symmetricContainment(*B_face, *edge))
 				transfers.append(edge);
 
 		for (auto edge : transfers)
@@ -25,11 +25,17 @@ struct interact {
 
 	Edge<Pgrd> * mark;
 
+	//mid_type is only measured once the following feature is known, until then the record is copied as exterior
 	interact() {
+		type = FaceRelationType::point_exterior;
+		mid_type = FaceRelationType::point_exterior;
 		mark = nullptr;
 	}
 };
 
+//the interactions of one boundary with a region, kept by value in boundary order
+typedef SVL<interact, 16> Interact_List;
+
 //represents the relation a query point has to a face
 //returned by getPointRelation
 struct FaceRelation {
@@ -44,24 +50,37 @@ struct FaceRelation {
 	Edge<Pgrd> * relevant;
 };
 
+//false if the point lies clearly outside the bounding box of the face, such points are on no edge of it
+bool inBounds(Face<Pgrd> const &rel, Pgrd const &test_point);
+
 FaceRelation const getPointRelation(Face<Pgrd> &rel, Pgrd const &test_point);
 
 FaceRelationType const getPointRelation(FLL<Pgrd> const & rel, Pgrd const &test_point);
 
+//whether the root of each face is interior to the other, the containment faces of one region are grouped by
+//faces never cross, so their orientation and area leave at most one point test to run
+bool symmetricContainment(Face<Pgrd> & a, Face<Pgrd> & b);
+
+//whether a holds the root of b, for a face b already known to hold the root of a, completing symmetricContainment
+bool completesContainment(Face<Pgrd> & a, Face<Pgrd> & b);
+
 bool merge(Region<Pgrd> * a, Region<Pgrd> * b);
 
-void determineInteriors(Region<Pgrd> *, FLL<interact *> &, FLL<Face<Pgrd> *> &,
+//merges sources into target, removing every edge shared between their boundaries at once, sources are left empty
+void mergeRegions(Region<Pgrd> * target, SVL<Region<Pgrd> *> const & sources);
+
+void determineInteriors(Region<Pgrd> *, Interact_List &, FLL<Face<Pgrd> *> &,
 	FLL<Face<Pgrd> *> &);
 
-bool markRegion(Region<Pgrd> *, FLL<Pgrd> const &, FLL<interact *> &);
+bool markRegion(Region<Pgrd> *, FLL<Pgrd> const &, Interact_List &);
 
 //type dependent
 void subAllocate(Region<Pgrd> * target, FLL<Pgrd> const & boundary,
-	FLL<Region<Pgrd> *> &exteriors, FLL<Region<Pgrd> *> & interiors);
+	SVL<Region<Pgrd> *> &exteriors, SVL<Region<Pgrd> *> & interiors);
 
 FaceRelation contains(Region<Pgrd> * target, Pgrd const & test_point);
 
-FLL<Region<Pgrd> *> getNeighbors(Region<Pgrd> * target);
+SVL<Region<Pgrd> *> getNeighbors(Region<Pgrd> * target);
 
 void cleanRegion(Region<Pgrd> * target);
 
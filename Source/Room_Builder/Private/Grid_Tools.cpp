@@ -1,5 +1,11 @@
 #include "Grid_Tools.h"
-#include "CoreMinimal.h"
+#include "Grid_Index.h"
+#include "Grid_Log.h"
+#include "Grid_Parallel.h"
+#include "Grid_Width.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 namespace chord_splits
 {
@@ -70,283 +76,738 @@ namespace chord_splits
 		}
 	};
 
-	grd minDiameter(FLL<Edge<Pgrd> *> const &relevants) {
-		//if no pair is small enough to split, add to ins and return
-		grd diameter = 0;
-		bool found = false;
-		grd min_offset, max_offset;
+	//minimum width across any edge direction
+	grd minDiameter(SVL<Edge<Pgrd> *> const &relevants) {
+		return Caliper_Width(relevants).minimum();
+	}
 
-		//check region size
-		for (auto edge : relevants) {
+	grd minDiameter(Region<Pgrd> * target) {
+		//walks the boundaries in place, nothing is collected
+		return Caliper_Width(target->boundaryEdges()).minimum();
+	}
+
+	//fills the cached geometry of the edges and of their faces
+	//edges and faces fill their caches on first read, so a parallel section must not be the first to read them,
+	//every cache its workers may touch is filled before it starts
+	template <class _R>
+	void settleGeometry(_R const & edges) {
+		for (auto edge : edges) {
+			edge->getLength();
+			edge->getFace()->getArea();
+		}
+	}
+
+	//minDiameter for each region, result[i] is for targets[i]
+	//regions are measured in parallel, they only read positions and write their own slot
+	void minDiameters(Region_List const &targets, SVL<grd> &result) {
+		int const first = result.size();
+		for (int index = 0; index < targets.size(); index++)
+			result.append(0);
+
+		for (auto target : targets)
+			settleGeometry(target->boundaryEdges());
+
+		parallelFor(targets.size(), 16, [&](int index) {
+			result[first + index] = minDiameter(targets[index]);
+		});
+	}
+
+	//whether the width across some edge direction is below thresh, stops at the first found
+	bool narrowerThan(SVL<Edge<Pgrd> *> const &relevants, grd const &thresh) {
+		return Caliper_Width(relevants).below(thresh);
+	}
+
+	//a concave corner at the end of edge, where a split may start
+	struct split_corner {
+		Edge<Pgrd> * edge;
+
+		Pgrd A_start;
+		Pgrd A_last;
+		Pgrd A_next;
+		bvs A_angle;
+
+		explicit split_corner(Edge<Pgrd> * target) :
+			edge(target),
+			A_start(target->getEnd()->getPosition()),
+			A_last(target->getStart()->getPosition() - A_start),
+			A_next(target->getNext()->getEnd()->getPosition() - A_start),
+			A_angle(A_next, A_last) {
+		}
 
-			Pgrd const A_start = edge->getEnd()->getPosition();
-			Pgrd const A_before = edge->getStart()->getPosition();
-			Pgrd const A = A_start - A_before;
+		//only clip concave corners
+		bool clips() const {
+			Pgrd const inner(A_last.Y, -A_last.X);
+			return inner.Dot(A_next) > 0;
+		}
+	};
+
+	//tests the splits from the corner to compare, replacing result with any shorter than it and thresh
+	//a split depends only on edge, the edge after it, and compare with the edges either side of it
+	void evaluateSplit(split_corner const & corner, Edge<Pgrd> * compare, grd const & thresh,
+		split_canidate & result, bool & found_option) {
+
+		Edge<Pgrd> * const edge = corner.edge;
+		Pgrd const & A_start = corner.A_start;
+		bvs const & A_angle = corner.A_angle;
+
+		Pgrd const B_start = compare->getStart()->getPosition();
+		Pgrd const B_end = compare->getEnd()->getPosition();
+		Pgrd const B_segment = B_end - B_start;
+
+		if (compare == edge || compare == edge->getNext()) {
+			return;
+		}
 
-			min_offset = linear_offset(A, A_start);
-			max_offset = min_offset;
+		//single convex corner cut
+		/*
+		if(A_angle.bounds_relation < 0){
 
-			for (auto compare : relevants) {
-				Pgrd const B_start = compare->getStart()->getPosition();
+			//project A_last onto B
+			if(!Pgrd::areParrallel(A_before, A_start, B_start, B_end))
+			{
+				Pgrd intersect;
+				Pgrd::getIntersect(A_before, A_start, B_start, B_end, intersect);
+			
+				Pgrd const segment = intersect - A_start;
+
+				//point is after A
+				if (A_last.Dot(segment) < 0) {
 
-				grd const raw = linear_offset(A, B_start);
+					//point lies on B
+					if (B_segment.Dot(intersect - B_start) >= 0 && B_segment.Dot(intersect - B_end) <= 0) {
+						grd const distance = segment.Size();
 
-				if (min_offset > raw)
-					min_offset = raw;
+						if (distance < thresh)
+							if (!found_option || distance < result.distance) {
+								found_option = true;
+								result.distance = distance;
 
-				if (max_offset < raw)
-					max_offset = raw;
+								result.A = A_start;
+								result.B = intersect;
+
+								result.A_edge = edge;
+								result.B_edge = compare;
+							}
+					}
+				}
 			}
+		
+			//project A_next onto B
+			if (!Pgrd::areParrallel(A_after, A_start, B_start, B_end))
+			{
+				Pgrd intersect;
+				Pgrd::getIntersect(A_after, A_start, B_start, B_end, intersect);
+				Pgrd const segment = intersect - A_start;
+
+				//point is after A
+				if (A_next.Dot(segment) < 0) {
 
-			grd const offset = max_offset - min_offset;
+					//point lies on B
+					if (B_segment.Dot(intersect - B_start) >= 0 && B_segment.Dot(intersect - B_end) <= 0) {
+						grd const distance = segment.Size();
 
-			if (offset < diameter || !found) {
-				found = true;
-				diameter = offset;
+						if (distance < thresh)
+							if (!found_option || distance < result.distance) {
+								found_option = true;
+								result.distance = distance;
+
+								result.A = A_start;
+								result.B = intersect;
+
+								result.A_edge = edge;
+								result.B_edge = compare;
+							}
+					}
+				}
 			}
 		}
-		return diameter;
-	}
+		*/
+
+		//convex cut attempt
+
+		{
+			Pgrd const B_last = compare->getLast()->getStart()->getPosition() - B_start;
+			bvs const B_angle(B_segment, B_last);
+			//if A convex
+			if (A_angle.bounds_relation < 0) {
+				//	if B_start convex
+				if (B_angle.bounds_relation < 0) {
+					Pgrd segment = B_start - A_start;
+					grd const distance = segment.Size();
 
-	grd minDiameter(Region<Pgrd> * target) {
-		//if no pair is small enough to split, add to ins and return
+					if (A_angle.test(segment))
+						if(B_angle.test(segment * -1))
+							if (distance < thresh)
+								if (!found_option || distance < result.distance) {
+									found_option = true;
+									result.distance = distance;
 
-		FLL<Edge<Pgrd> *> relevants;
+									result.A = A_start;
+									result.B = B_start;
 
-		for (auto border : target->getBounds()) {
-			border->getLoopEdges(relevants);
+									result.A_edge = edge;
+									result.B_edge = compare;
+								}
+				}
+			}
 		}
 
-		return minDiameter(relevants);
+
+
+
+		//get shortest distance (projection of A onto -B- )
+		{
+			Pgrd const B_perp(-B_segment.Y, B_segment.X);
+
+			if (!A_angle.test(B_perp))
+				return;
+
+			Pgrd const offset = A_start - B_start;
+
+			if (B_perp.Dot(offset) >= 0)
+				return;
+
+			Pgrd intersect;
+
+			if (offset.Dot(B_end - B_start) <= 0) {
+				intersect = B_start;
+				Pgrd const B_last = compare->getLast()->getStart()->getPosition();
+
+				if (!betweenVectors(B_end - B_start, B_last - B_start, offset))
+					return;
+			}
+			else if ((A_start - B_end).Dot(B_start - B_end) <= 0) {
+				intersect = B_end;
+
+				Pgrd const B_next = compare->getNext()->getEnd()->getPosition();
+
+				if (!betweenVectors(B_next - B_end, B_start - B_end, A_start - B_end))
+					return;
+			}
+			else
+				Pgrd::getIntersect(B_start, B_end, A_start, A_start + B_perp, intersect);
+
+			Pgrd const segment = intersect - A_start;
+
+			if (!A_angle.test(segment))
+				return;
+
+			grd const distance = segment.Size();
+
+			if (distance < thresh)
+				if (!found_option || distance < result.distance) {
+					found_option = true;
+					result.distance = distance;
+
+					result.A = A_start;
+					result.B = intersect;
+
+					result.A_edge = edge;
+					result.B_edge = compare;
+				}
+		}
 	}
 
-	void chord_clean(Region<Pgrd> * target, grd const & thresh, Region_List & sections) {
-		//if no pair is small enough to split, add to ins and return
+	//a split waiting in a region's queue, measured in generation
+	struct queued_split {
+		split_canidate split;
+		int generation;
 
-		FLL<Edge<Pgrd> *> relevants;
+		//queues are max heaps, the shortest split rises to the top
+		bool operator<(queued_split const & target) const {
+			return split.distance > target.split.distance;
+		}
+	};
 
-		for (auto border : target->getBounds()) {
-			border->getLoopEdges(relevants);
+	//a region waiting to be cleaned, with the splits found within it
+	//splits are current as of generation checked, a region not yet seeded has none
+	struct chord_work {
+		Region<Pgrd> * region;
+		SVL<queued_split> queue;
+		bool seeded;
+		int checked;
+	};
+
+	//the generation each edge last changed in, kept apart from the edge marks callers may be holding
+	//edges are looked up by pool handle, an edge never stamped reads as generation 0
+	class Edge_Stamps {
+		DCEL<Pgrd> const * universe;
+		std::vector<int> stamps;
+
+	public:
+		explicit Edge_Stamps(DCEL<Pgrd> const * universe) : universe(universe) {
 		}
 
-		if (minDiameter(relevants) < thresh) {
+		int get(Edge<Pgrd> const * edge) const {
+			unsigned const handle = universe->getHandle(edge);
+			return handle < stamps.size() ? stamps[handle] : 0;
+		}
 
-			sections.push(target);
-			return;
+		void set(Edge<Pgrd> const * edge, int generation) {
+			unsigned const handle = universe->getHandle(edge);
+			if (handle >= stamps.size())
+				stamps.resize(handle + 1, 0);
+			stamps[handle] = generation;
 		}
+	};
+
+	//splits measured before any edge they depend on last changed are stale
+	bool isCurrent(queued_split const & focus, Region<Pgrd> * region, Edge_Stamps const & stamps) {
+		Edge<Pgrd> * const A = focus.split.A_edge;
+		Edge<Pgrd> * const B = focus.split.B_edge;
+
+		if (A->getFace()->getGroup() != region || B->getFace()->getGroup() != region)
+			return false;
+
+		return stamps.get(A) <= focus.generation && stamps.get(A->getNext()) <= focus.generation &&
+			stamps.get(B->getLast()) <= focus.generation && stamps.get(B) <= focus.generation &&
+			stamps.get(B->getNext()) <= focus.generation;
+	}
+
+	//appends every split from the corner to compare
+	void measureSplit(split_corner const & corner, Edge<Pgrd> * compare, grd const & thresh, int generation,
+		SVL<queued_split> & found) {
 
-		split_canidate result;
+		queued_split product;
 		bool found_option = false;
 
-		for (auto edge : relevants) {
+		evaluateSplit(corner, compare, thresh, product.split, found_option);
 
-			Pgrd const A_start = edge->getEnd()->getPosition();
-			Pgrd const A_before = edge->getStart()->getPosition();
-			Pgrd const A_after = edge->getNext()->getEnd()->getPosition();
+		if (!found_option)
+			return;
 
-			//Pgrd const A = A_start - A_before;
+		product.generation = generation;
 
-			Pgrd const A_last = A_before - A_start;
-			Pgrd const A_next = A_after - A_start;
+		found.append(product);
+	}
 
-			//only clip concave corners
-			{
-				Pgrd const inner(A_last.Y, -A_last.X);
-				if (inner.Dot(A_next) <= 0)
-					continue;
-			}
+	queued_split popSplit(SVL<queued_split> & queue) {
+		std::pop_heap(queue.data(), queue.data() + queue.size());
 
-			bvs const A_angle(A_next, A_last);
+		queued_split product = queue[queue.size() - 1];
+		queue.removeAt(queue.size() - 1);
 
-			for (auto compare : relevants) {
-				Pgrd const B_start = compare->getStart()->getPosition();
-				Pgrd const B_end = compare->getEnd()->getPosition();
-				Pgrd const B_segment = B_end - B_start;
+		return product;
+	}
 
-				if (compare == edge || compare == edge->getNext()) {
-					continue;
+	int scanOrder(SVL<Edge<Pgrd> *> const & relevants, Edge<Pgrd> * edge) {
+		for (int index = 0; index < relevants.size(); index++)
+			if (relevants[index] == edge)
+				return index;
+		return relevants.size();
+	}
+
+	//takes the shortest current split in the region
+	//equal splits go to the one a scan of relevants, corners then targets, would meet first
+	bool takeSplit(chord_work & work, SVL<Edge<Pgrd> *> const & relevants, Edge_Stamps const & stamps, split_canidate & result) {
+		SVL<queued_split> & queue = work.queue;
+
+		while (queue.size() > 0 && !isCurrent(queue[0], work.region, stamps))
+			popSplit(queue);
+
+		if (queue.size() == 0)
+			return false;
+
+		queued_split best = popSplit(queue);
+
+		SVL<queued_split> ties;
+		while (queue.size() > 0 && !(queue[0].split.distance > best.split.distance)) {
+			queued_split focus = popSplit(queue);
+			if (isCurrent(focus, work.region, stamps))
+				ties.append(focus);
+		}
+
+		if (ties.size() > 0) {
+			int best_A = scanOrder(relevants, best.split.A_edge);
+			int best_B = scanOrder(relevants, best.split.B_edge);
+
+			for (auto & focus : ties) {
+				int const A = scanOrder(relevants, focus.split.A_edge);
+				int const B = scanOrder(relevants, focus.split.B_edge);
+
+				if (A < best_A || (A == best_A && B < best_B)) {
+					std::swap(focus, best);
+					best_A = A;
+					best_B = B;
 				}
+			}
 
-				//single convex corner cut
-				/*
-				if(A_angle.bounds_relation < 0){
+			for (auto const & focus : ties) {
+				queue.append(focus);
+				std::push_heap(queue.data(), queue.data() + queue.size());
+			}
+		}
 
-					//project A_last onto B
-					if(!Pgrd::areParrallel(A_before, A_start, B_start, B_end))
-					{
-						Pgrd intersect;
-						Pgrd::getIntersect(A_before, A_start, B_start, B_end, intersect);
-					
-						Pgrd const segment = intersect - A_start;
+		result = best.split;
+		return true;
+	}
 
-						//point is after A
-						if (A_last.Dot(segment) < 0) {
+	//appends the region's edges that may lie within thresh of the corner, any split from it ends on one of these
+	void nearbyTargets(Edge_Grid const & grid, Region<Pgrd> * region, split_corner const & corner, grd const & thresh,
+		SVL<Edge<Pgrd> *> & result) {
 
-							//point lies on B
-							if (B_segment.Dot(intersect - B_start) >= 0 && B_segment.Dot(intersect - B_end) <= 0) {
-								grd const distance = segment.Size();
+		Pgrd const reach(thresh, thresh);
 
-								if (distance < thresh)
-									if (!found_option || distance < result.distance) {
-										found_option = true;
-										result.distance = distance;
+		SVL<Edge<Pgrd> *> hits;
+		grid.query(corner.A_start - reach, corner.A_start + reach, hits);
 
-										result.A = A_start;
-										result.B = intersect;
+		for (auto edge : hits)
+			if (edge->getFace()->getGroup() == region)
+				result.append(edge);
+	}
 
-										result.A_edge = edge;
-										result.B_edge = compare;
-									}
-							}
-						}
-					}
-				
-					//project A_next onto B
-					if (!Pgrd::areParrallel(A_after, A_start, B_start, B_end))
-					{
-						Pgrd intersect;
-						Pgrd::getIntersect(A_after, A_start, B_start, B_end, intersect);
-						Pgrd const segment = intersect - A_start;
-
-						//point is after A
-						if (A_next.Dot(segment) < 0) {
-
-							//point lies on B
-							if (B_segment.Dot(intersect - B_start) >= 0 && B_segment.Dot(intersect - B_end) <= 0) {
-								grd const distance = segment.Size();
-
-								if (distance < thresh)
-									if (!found_option || distance < result.distance) {
-										found_option = true;
-										result.distance = distance;
-
-										result.A = A_start;
-										result.B = intersect;
-
-										result.A_edge = edge;
-										result.B_edge = compare;
-									}
-							}
-						}
-					}
+	//corners measured together, each block of corners is measured into its own list
+	enum : int { corner_block = 32 };
+
+	//queues the splits from each corner, rows against their nearby edges and the others against targets
+	//only positions and links are read until the splits are queued, so blocks of corners are measured in parallel
+	//and queued in corner order, matching a serial scan, the caller settles the region's geometry beforehand
+	void queueSplits(chord_work & work, SVL<Edge<Pgrd> *> const & corners, SVL<bool> const & rows,
+		SVL<Edge<Pgrd> *> const & targets, Edge_Grid const & grid, grd const & thresh, int generation) {
+
+		int const blocks = (corners.size() + corner_block - 1) / corner_block;
+		std::vector<SVL<queued_split>> found(blocks);
+
+		parallelFor(blocks, 4, [&](int block) {
+			int const last = std::min(corners.size(), (block + 1) * corner_block);
+
+			SVL<Edge<Pgrd> *> nearby;
+
+			for (int index = block * corner_block; index < last; index++) {
+				split_corner const corner(corners[index]);
+
+				if (rows[index]) {
+					nearby.clear();
+					nearbyTargets(grid, work.region, corner, thresh, nearby);
+
+					for (auto compare : nearby)
+						measureSplit(corner, compare, thresh, generation, found[block]);
 				}
-				*/
-
-				//convex cut attempt
-
-				{
-					Pgrd const B_last = compare->getLast()->getStart()->getPosition() - B_start;
-					bvs const B_angle(B_segment, B_last);
-					//if A convex
-					if (A_angle.bounds_relation < 0) {
-						//	if B_start convex
-						if (B_angle.bounds_relation < 0) {
-							Pgrd segment = B_start - A_start;
-							grd const distance = segment.Size();
-
-							if (A_angle.test(segment))
-								if(B_angle.test(segment * -1))
-									if (distance < thresh)
-										if (!found_option || distance < result.distance) {
-											found_option = true;
-											result.distance = distance;
-
-											result.A = A_start;
-											result.B = B_start;
-
-											result.A_edge = edge;
-											result.B_edge = compare;
-										}
-						}
-					}
+				else {
+					for (auto compare : targets)
+						measureSplit(corner, compare, thresh, generation, found[block]);
 				}
+			}
+		});
 
+		SVL<queued_split> & queue = work.queue;
 
+		for (int block = 0; block < blocks; block++) {
+			for (auto const & focus : found[block]) {
+				queue.append(focus);
+				std::push_heap(queue.data(), queue.data() + queue.size());
+			}
+		}
+	}
 
+	//measures every split in the region
+	void seedSplits(chord_work & work, SVL<Edge<Pgrd> *> const & relevants, Edge_Grid const & grid, grd const & thresh,
+		int generation) {
 
-				//get shortest distance (projection of A onto -B- )
-				{
-					Pgrd const B_perp(-B_segment.Y, B_segment.X);
+		SVL<Edge<Pgrd> *> corners;
+		SVL<bool> rows;
 
-					if (!A_angle.test(B_perp))
-						continue;
+		for (auto edge : relevants) {
+			if (!split_corner(edge).clips())
+				continue;
 
-					Pgrd const offset = A_start - B_start;
+			corners.append(edge);
+			rows.append(true);
+		}
 
-					if (B_perp.Dot(offset) >= 0)
-						continue;
+		//every corner is a row, nothing is measured against targets
+		SVL<Edge<Pgrd> *> const targets;
+		queueSplits(work, corners, rows, targets, grid, thresh, generation);
 
-					Pgrd intersect;
+		work.seeded = true;
+		work.checked = generation;
+	}
 
-					if (offset.Dot(B_end - B_start) <= 0) {
-						intersect = B_start;
-						Pgrd const B_last = compare->getLast()->getStart()->getPosition();
+	//measures the splits in the region that depend on an edge changed since it was last checked
+	//splits elsewhere change neighboring regions too, subdividing an edge subdivides its inverse
+	void refreshSplits(chord_work & work, SVL<Edge<Pgrd> *> const & relevants, Edge_Grid const & grid, grd const & thresh,
+		Edge_Stamps const & stamps, int generation) {
+		int const since = work.checked;
+		work.checked = generation;
 
-						if (!betweenVectors(B_end - B_start, B_last - B_start, offset))
-							continue;
-					}
-					else if ((A_start - B_end).Dot(B_start - B_end) <= 0) {
-						intersect = B_end;
+		auto changed = [&stamps, since](Edge<Pgrd> * edge) {
+			return stamps.get(edge) > since;
+		};
 
-						Pgrd const B_next = compare->getNext()->getEnd()->getPosition();
+		//corners whose edge or following edge changed, against every nearby target
+		//then targets that changed or whose neighbors changed, against every other corner
+		SVL<Edge<Pgrd> *> targets;
+		for (auto edge : relevants)
+			if (changed(edge->getLast()) || changed(edge) || changed(edge->getNext()))
+				targets.append(edge);
 
-						if (!betweenVectors(B_next - B_end, B_start - B_end, A_start - B_end))
-							continue;
-					}
-					else
-						Pgrd::getIntersect(B_start, B_end, A_start, A_start + B_perp, intersect);
+		SVL<Edge<Pgrd> *> corners;
+		SVL<bool> rows;
 
-					Pgrd const segment = intersect - A_start;
+		for (auto edge : relevants) {
+			if (!split_corner(edge).clips())
+				continue;
 
-					if (!A_angle.test(segment))
-						continue;
+			corners.append(edge);
+			rows.append(changed(edge) || changed(edge->getNext()));
+		}
 
-					grd const distance = segment.Size();
+		queueSplits(work, corners, rows, targets, grid, thresh, generation);
+	}
 
-					if (distance < thresh)
-						if (!found_option || distance < result.distance) {
-							found_option = true;
-							result.distance = distance;
+	//splits region along result, returning the new region if the split divides it
+	//the edges a split changes are stamped with generation, new edges are added to grid when there is one
+	Region<Pgrd> * applySplit(Region<Pgrd> * region, split_canidate & result, Edge_Stamps & stamps, int generation,
+		Edge_Grid * grid) {
+		if (result.B == result.B_edge->getStart()->getPosition()) {
+			result.B_edge = result.B_edge->getLast();
+		}
+		else if (result.B != result.B_edge->getEnd()->getPosition()) {
+			//in-line, subdivide
+			result.B_edge->subdivide(result.B);
 
-							result.A = A_start;
-							result.B = intersect;
+			if (grid != nullptr) {
+				grid->append(result.B_edge->getNext());
+				grid->append(result.B_edge->getNext()->getInv());
+			}
+		}
+		//split now occurs at end of A_edge and B_edge
+		auto P = RegionAdd(region, result.A_edge, result.B_edge);
 
-							result.A_edge = edge;
-							result.B_edge = compare;
-						}
-				}
+		if (grid != nullptr) {
+			grid->append(result.A_edge->getNext());
+			grid->append(result.B_edge->getNext());
+		}
+
+		//the new edges, the edges they join, and the edge after a subdivided one
+		for (auto end : { result.A_edge, result.B_edge }) {
+			Edge<Pgrd> * focus = end;
+			for (int step = 0; step < 4; step++) {
+				stamps.set(focus, generation);
+				stamps.set(focus->getInv(), generation);
+				focus = focus->getNext();
 			}
 		}
 
-		if (found_option) {
-			if (result.B == result.B_edge->getStart()->getPosition()) {
-				result.B_edge = result.B_edge->getLast();
+		return P;
+	}
+
+	//splits the region along chords shorter than thresh until every piece is narrow or has none
+	//each split only changes a few edges, so the splits found before it are kept, and only those that
+	//depend on the changed edges are measured again
+	void chord_clean(Region<Pgrd> * target, grd const & thresh, Region_List & sections) {
+		Edge_Stamps stamps(target->getUni());
+		int generation = 1;
+
+		//every edge of the region and of the pieces cut from it, built when first needed
+		std::unique_ptr<Edge_Grid> grid;
+
+		//pieces split off are cleaned after the piece they left, depth first, matching the order of recursion
+		std::vector<chord_work> pending(1);
+		pending[0].region = target;
+		pending[0].seeded = false;
+		pending[0].checked = 0;
+
+		while (pending.size() > 0) {
+			chord_work & work = pending.back();
+			Region<Pgrd> * region = work.region;
+
+			SVL<Edge<Pgrd> *> relevants;
+			for (auto border : region->getBounds())
+				border->getLoopEdges(relevants);
+
+			split_canidate result;
+			bool found_option = false;
+
+			//narrow regions are left whole
+			if (!narrowerThan(relevants, thresh)) {
+				//the splits are measured in parallel, over these edges only
+				settleGeometry(relevants);
+
+				if (!work.seeded) {
+					grid.reset(new Edge_Grid(relevants));
+					seedSplits(work, relevants, *grid, thresh, generation);
+				}
+				else if (work.checked < generation) {
+					refreshSplits(work, relevants, *grid, thresh, stamps, generation);
+				}
+
+				found_option = takeSplit(work, relevants, stamps, result);
+			}
+
+			if (!found_option) {
+				sections.push(region);
+
+				pending.pop_back();
+				continue;
 			}
-			else if (result.B != result.B_edge->getEnd()->getPosition()) {
-				//in-line, subdivide
-				result.B_edge->subdivide(result.B);
+
+			generation++;
+			auto P = applySplit(region, result, stamps, generation, grid.get());
+
+			//splits that now fall in the new piece move with it
+			chord_work part{};
+			if (P != nullptr) {
+				part.region = P;
+				part.seeded = true;
+				part.checked = work.checked;
 			}
-			//split now occurs at end of A_edge and B_edge
-			auto P = RegionAdd(target, result.A_edge, result.B_edge);
 
-			chord_clean(target, thresh, sections);
+			{
+				SVL<queued_split> kept;
+
+				for (auto const & focus : work.queue) {
+					if (isCurrent(focus, region, stamps))
+						kept.append(focus);
+					else if (P != nullptr && isCurrent(focus, P, stamps))
+						part.queue.append(focus);
+				}
+
+				work.queue = std::move(kept);
+
+				std::make_heap(work.queue.data(), work.queue.data() + work.queue.size());
+				if (P != nullptr)
+					std::make_heap(part.queue.data(), part.queue.data() + part.queue.size());
+			}
 
 			if (P != nullptr) {
-				chord_clean(P, thresh, sections);
+				//below the current piece, so it is finished first
+				chord_work current = std::move(work);
+				pending.pop_back();
+				pending.push_back(std::move(part));
+				pending.push_back(std::move(current));
 			}
 		}
-		else {
+	}
+
+	//a corner's narrowest chord, where the corner falls in a scan of the region,
+	//and the neighbors it was measured with
+	struct corner_width {
+		split_canidate split;
+		int order;
+
+		Edge<Pgrd> * A_next;
+		Edge<Pgrd> * B_last;
+		Edge<Pgrd> * B_next;
+		Pgrd A_reach;
+		Pgrd B_end;
+		Pgrd B_reach;
+
+		explicit corner_width(int index) : order(index) {
+		}
+
+		void record() {
+			A_next = split.A_edge->getNext();
+			B_last = split.B_edge->getLast();
+			B_next = split.B_edge->getNext();
+			A_reach = A_next->getEnd()->getPosition();
+			B_end = split.B_edge->getEnd()->getPosition();
+			B_reach = B_next->getEnd()->getPosition();
+		}
+
+		//whether every position the chord was measured from is still linked as it was
+		//splits only add edges and subdivide them, so a changed neighborhood shows in its links or end points
+		bool current() const {
+			return split.A_edge->getNext() == A_next && split.B_edge->getLast() == B_last && split.B_edge->getNext() == B_next &&
+				A_next->getEnd()->getPosition() == A_reach && split.B_edge->getEnd()->getPosition() == B_end &&
+				B_next->getEnd()->getPosition() == B_reach;
+		}
+
+		bool operator<(corner_width const & target) const {
+			return split.distance < target.split.distance ||
+				(!(target.split.distance < split.distance) && order < target.order);
+		}
+	};
+
+	//splits the region along the narrowest chord from each concave corner, narrowest first
+	//widths are measured once, a chord whose neighborhood an earlier split changed is dropped rather than measured again
+	//this is a corner heuristic, not a straight skeleton or medial axis, and it only measures width where a concave
+	//corner opens a narrow part; a piece may keep a chord that measuring again would have found, which chord_clean would cut
+	void width_clean(Region<Pgrd> * target, grd const & thresh, Region_List & sections) {
+		SVL<Edge<Pgrd> *> relevants;
+		for (auto border : target->getBounds())
+			border->getLoopEdges(relevants);
+
+		//narrow regions are left whole
+		if (narrowerThan(relevants, thresh)) {
 			sections.push(target);
+			return;
+		}
+
+		//measured widths belong to generation zero, each split stamps the edges it changes with the next
+		Edge_Stamps stamps(target->getUni());
+		int generation = 0;
+
+		SVL<corner_width> widths;
+		{
+			Edge_Grid grid(relevants);
+			SVL<Edge<Pgrd> *> nearby;
+
+			for (int index = 0; index < relevants.size(); index++) {
+				split_corner const corner(relevants[index]);
+				if (!corner.clips())
+					continue;
+
+				nearby.clear();
+				nearbyTargets(grid, target, corner, thresh, nearby);
+
+				corner_width product(index);
+				bool found = false;
+
+				for (auto compare : nearby)
+					evaluateSplit(corner, compare, thresh, product.split, found);
+
+				if (!found)
+					continue;
+
+				product.record();
+				widths.append(product);
+			}
+		}
+
+		std::sort(widths.data(), widths.data() + widths.size());
+
+		Region_List pieces;
+		pieces.append(target);
+
+		SVL<Edge<Pgrd> *> piece_edges;
+
+		for (auto & width : widths) {
+			Region<Pgrd> * region = width.split.A_edge->getFace()->getGroup();
+
+			if (region == nullptr || width.split.B_edge->getFace()->getGroup() != region || !width.current())
+				continue;
+
+			//a piece that became narrow is not split further
+			piece_edges.clear();
+			for (auto border : region->getBounds())
+				border->getLoopEdges(piece_edges);
+
+			if (narrowerThan(piece_edges, thresh))
+				continue;
+
+			auto P = applySplit(region, width.split, stamps, ++generation, nullptr);
+
+			if (P != nullptr)
+				pieces.append(P);
 		}
+
+		for (auto piece : pieces)
+			sections.push(piece);
 	}
 }
 
 void sortSmalls(Region_List &source, grd const &width, Region_List &smalls) {
 	Region_List bigs;
 
-	for (auto target : source) {
-		grd diameter = chord_splits::minDiameter(target);
-		UE_LOG(LogTemp, Warning, TEXT("D: %f"), diameter.n);
+	SVL<grd> diameters;
+	chord_splits::minDiameters(source, diameters);
+
+	for (int index = 0; index < source.size(); index++) {
+		auto target = source[index];
+		grd const & diameter = diameters[index];
+
+		gridLog("D: %f", diameter.value());
 		if (diameter < width)
 			smalls.append(target);
 		else
@@ -357,27 +818,97 @@ void sortSmalls(Region_List &source, grd const &width, Region_List &smalls) {
 	source.absorb(bigs);
 }
 
+//merges every group of touching regions in nulls into the earliest region of the group
+//touching regions are found in one pass over the boundaries and grouped with union find
 void mergeGroup(Region_List & nulls) {
-	for (auto focus = nulls.begin(); focus != nulls.end(); ++focus) {
-		merge(*focus, *focus);
+	if (nulls.size() == 0)
+		return;
+
+	//a region's index in nulls, looked up by pool handle, regions outside nulls read as -1
+	DCEL<Pgrd> const * universe = nulls[0]->getUni();
+
+	std::vector<int> place;
+	for (int index = 0; index < nulls.size(); index++) {
+		unsigned const handle = universe->getHandle(nulls[index]);
+		if (handle >= place.size())
+			place.resize(handle + 1, -1);
+		place[handle] = index;
+	}
+
+	auto placeOf = [&](Region<Pgrd> const * region) {
+		unsigned const handle = universe->getHandle(region);
+		return handle < place.size() ? place[handle] : -1;
+	};
+
+	SVL<int> parent;
+	for (int index = 0; index < nulls.size(); index++)
+		parent.append(index);
+
+	auto find = [&parent](int index) {
+		while (parent[index] != index) {
+			parent[index] = parent[parent[index]];
+			index = parent[index];
+		}
+		return index;
+	};
 
-		for (auto compare = focus.next(); compare != nulls.end();) {
-			auto v = *compare;
+	for (int index = 0; index < nulls.size(); index++) {
+		for (auto edge : nulls[index]->boundaryEdges()) {
+			Region<Pgrd> * neighbor = edge->getInv()->getFace()->getGroup();
 
-			++compare;
+			if (neighbor == nullptr || placeOf(neighbor) == -1)
+				continue;
 
-			if (merge(*focus, v))
-				nulls.remove(v);
+			//the earlier region roots the group
+			int const a = find(index);
+			int const b = find(placeOf(neighbor));
+
+			if (a < b)
+				parent[b] = a;
+			else if (b < a)
+				parent[a] = b;
+		}
+	}
+
+	//chains each group's later members in list order, after its root
+	SVL<int> following;
+	SVL<int> tail;
+	for (int index = 0; index < nulls.size(); index++) {
+		following.append(-1);
+		tail.append(index);
+
+		int const root = find(index);
+		if (root != index) {
+			following[tail[root]] = index;
+			tail[root] = index;
 		}
 	}
+
+	Region_List roots;
+	for (int index = 0; index < nulls.size(); index++) {
+		if (parent[index] != index)
+			continue;
+
+		Region_List members;
+		for (int member = following[index]; member != -1; member = following[member])
+			members.append(nulls[member]);
+
+		mergeRegions(nulls[index], members);
+		roots.append(nulls[index]);
+	}
+
+	nulls = std::move(roots);
 }
 
 //cuts the region along any chord less than width, returns simple regions
-Region_List Cut(Region<Pgrd> * target, grd const &width) {
+Region_List Cut(Region<Pgrd> * target, grd const &width, cut_strategy strategy) {
 
 	Region_List parts;
 
-	chord_splits::chord_clean(target, width, parts);
+	if (strategy == cut_widths)
+		chord_splits::width_clean(target, width, parts);
+	else
+		chord_splits::chord_clean(target, width, parts);
 
 	for (auto region : parts) {
 		merge(region, region);
@@ -387,12 +918,12 @@ Region_List Cut(Region<Pgrd> * target, grd const &width) {
 }
 
 //cuts the regions along any chord less than width, returns simple regions
-void Cut(Region_List &targets, grd const &width) {
+void Cut(Region_List &targets, grd const &width, cut_strategy strategy) {
 
 	Region_List parts;
 
 	for (auto target : targets) {
-		auto p = Cut(target, width);
+		auto p = Cut(target, width, strategy);
 		parts.absorb(p);
 	}
 
@@ -400,10 +931,10 @@ void Cut(Region_List &targets, grd const &width) {
 	targets.absorb(parts);
 }
 
-void removeSmallSections(Region_List &target, grd const &min_width, Region_List &smalls) {
+void removeSmallSections(Region_List &target, grd const &min_width, Region_List &smalls, cut_strategy strategy) {
 	mergeGroup(target);
 
-	Cut(target, min_width);
+	Cut(target, min_width, strategy);
 
 	sortSmalls(target, min_width, smalls);
 
@@ -412,8 +943,8 @@ void removeSmallSections(Region_List &target, grd const &min_width, Region_List
 	mergeGroup(smalls);
 }
 
-void sizeRestrict(Region_List &target, grd const &min_width, Region_List &outs) {
-	Cut(target, min_width);
+void sizeRestrict(Region_List &target, grd const &min_width, Region_List &outs, cut_strategy strategy) {
+	Cut(target, min_width, strategy);
 
 	sortSmalls(target, min_width, outs);
 
@@ -423,13 +954,83 @@ void sizeRestrict(Region_List &target, grd const &min_width, Region_List &outs)
 	mergeGroup(outs);
 }
 
+namespace allocation
+{
+	//an axis aligned box, unbounded when it covers the whole plane
+	struct extent {
+		double min_x, min_y, max_x, max_y;
+		bool bounded;
+	};
+
+	extent boundaryExtent(FLL<Pgrd> const &boundary) {
+		extent product = { 0, 0, 0, 0, true };
+		bool found = false;
+
+		for (auto const & point : boundary) {
+			if (!found || point.X.value() < product.min_x) product.min_x = point.X.value();
+			if (!found || point.Y.value() < product.min_y) product.min_y = point.Y.value();
+			if (!found || point.X.value() > product.max_x) product.max_x = point.X.value();
+			if (!found || point.Y.value() > product.max_y) product.max_y = point.Y.value();
+
+			found = true;
+		}
+
+		return product;
+	}
+
+	//a region lies within its outer boundaries, one with only inverted boundaries is unbounded
+	extent regionExtent(Region<Pgrd> * region) {
+		extent product = { 0, 0, 0, 0, false };
+
+		for (auto face : region->getBounds()) {
+			if (face->getArea() < 0)
+				continue;
+
+			Pgrd const & box_min = face->getBoxMin();
+			Pgrd const & box_max = face->getBoxMax();
+
+			if (!product.bounded || box_min.X.value() < product.min_x) product.min_x = box_min.X.value();
+			if (!product.bounded || box_min.Y.value() < product.min_y) product.min_y = box_min.Y.value();
+			if (!product.bounded || box_max.X.value() > product.max_x) product.max_x = box_max.X.value();
+			if (!product.bounded || box_max.Y.value() > product.max_y) product.max_y = box_max.Y.value();
+
+			product.bounded = true;
+		}
+
+		return product;
+	}
+
+	//whether the boxes are clearly apart, padded so that anything the segment tests may call touching overlaps
+	bool apart(extent const &a, extent const &b) {
+		if (!a.bounded || !b.bounded)
+			return false;
+
+		double const pad = 4 * grid_epsilon * (std::fmax(
+			std::fmax(a.max_x - a.min_x, a.max_y - a.min_y),
+			std::fmax(b.max_x - b.min_x, b.max_y - b.min_y)) + 1);
+
+		return a.max_x + pad < b.min_x || b.max_x + pad < a.min_x || a.max_y + pad < b.min_y || b.max_y + pad < a.min_y;
+	}
+
+	//subAllocates each region of set by boundary
+	//a region apart from the boundary is exterior to it, and is passed to exteriors without tracing the boundary
+	void subAllocateAll(FLL<Pgrd> const &boundary, Region_List &set, Region_List &exteriors, Region_List &interiors) {
+		extent const reach = boundaryExtent(boundary);
+
+		for (auto member : set) {
+			if (apart(regionExtent(member), reach))
+				exteriors.push(member);
+			else
+				subAllocate(member, boundary, exteriors, interiors);
+		}
+	}
+}
+
 Region_List allocateBoundaryFrom(FLL<Pgrd> const &boundary, Region_List &set) {
 	Region_List _ins;
 	Region_List _outs;
 
-	for (auto member : set) {
-		subAllocate(member, boundary, _outs, _ins);
-	}
+	allocation::subAllocateAll(boundary, set, _outs, _ins);
 
 	mergeGroup(_ins);
 
@@ -445,18 +1046,16 @@ Region_List allocateBoundaryFrom(FLL<Pgrd> const &boundary, Region_List &set) {
 void allocateBoundaryFromInto(FLL<Pgrd> const &boundary, Region_List &set, Region_List &result) {
 	Region_List _outs;
 
-	for (auto member : set) {
-		subAllocate(member, boundary, _outs, result);
-	}
+	allocation::subAllocateAll(boundary, set, _outs, result);
 
 	mergeGroup(result);
 
-	UE_LOG(LogTemp, Warning, TEXT("results"));
+	gridLog("results");
 	for(auto a : result)
 		for (auto bound : a->getBounds()) {
-			UE_LOG(LogTemp, Warning, TEXT("face >r:"));
+			gridLog("face >r:");
 			for (auto point : bound->getLoopPoints()) {
-				UE_LOG(LogTemp, Warning, TEXT("(%f,%f)"), point.X.n, point.Y.n);
+				gridLog("(%f,%f)", point.X.value(), point.Y.value());
 			}
 		}
 
@@ -467,13 +1066,31 @@ void allocateBoundaryFromInto(FLL<Pgrd> const &boundary, Region_List &set, Regio
 	set.absorb(_outs);
 }
 
+void allocateBoundariesFromInto(FLL<FLL<Pgrd> *> const &boundaries, Region_List &set, Region_List &result) {
+	//each boundary is still traced through the set in turn, this saves the repeated merging of the set, not the overlay
+	//pieces left outside one boundary are allocated by the next, and only merged once at the end
+	//the few pieces inside are merged as they are found, cleaning corners they share with the pieces outside
+	//those corners decide where later boundaries cut, so merging the inside once at the end would change the layout
+	for (auto boundary : boundaries) {
+		Region_List _outs;
+
+		allocation::subAllocateAll(*boundary, set, _outs, result);
+
+		mergeGroup(result);
+
+		set.clear();
+
+		set.absorb(_outs);
+	}
+
+	mergeGroup(set);
+}
+
 Region_List allocateCleanedBoundaryFrom(FLL<Pgrd> const &boundary, grd const &min_width, Region_List &set) {
 	Region_List _ins;
 	Region_List _outs;
 
-	for (auto member : set) {
-		subAllocate(member, boundary, _outs, _ins);
-	}
+	allocation::subAllocateAll(boundary, set, _outs, _ins);
 
 	mergeGroup(_ins);
 
@@ -489,9 +1106,7 @@ Region_List allocateCleanedBoundaryFrom(FLL<Pgrd> const &boundary, grd const &mi
 void allocateCleanedBoundaryFromInto(FLL<Pgrd> const &boundary, grd const &min_width, Region_List &set, Region_List &result) {
 	Region_List _outs;
 
-	for (auto member : set) {
-		subAllocate(member, boundary, _outs, result);
-	}
+	allocation::subAllocateAll(boundary, set, _outs, result);
 
 	mergeGroup(result);
 
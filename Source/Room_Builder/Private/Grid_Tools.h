@@ -1,7 +1,23 @@
 #pragma once
 #include "Grid_Region.h"
 
-typedef FLL<Region<Pgrd> *> Region_List;
+typedef SVL<Region<Pgrd> *> Region_List;
+
+//how Cut finds the narrow sections of a region
+enum cut_strategy {
+	//splits along the shortest chord below the width, measuring again after every split
+	cut_chords,
+	//measures the narrowest chord from every concave corner once, then splits along them narrowest first
+	cut_widths
+};
+
+///<summary>
+///<para>Cuts the regions along chords narrower than width, replacing them with the pieces</para>
+///<para>&#160;</para>
+///<para>Assumes: -</para>
+///<para>Fulfills: targets are simple</para>
+///</summary>
+void Cut(Region_List &targets, grd const &width, cut_strategy strategy = cut_chords);
 
 ///<summary>
 ///<para>Trims small sub-regions from target with Cull and merges them to outs</para>
@@ -9,7 +25,7 @@ typedef FLL<Region<Pgrd> *> Region_List;
 ///<para>Assumes: -</para>
 ///<para>Fulfills: outs is maximally merged. target is maximally merged</para>
 ///</summary>
-void removeSmallSections(Region_List &target, grd const &min_width, Region_List &smalls);
+void removeSmallSections(Region_List &target, grd const &min_width, Region_List &smalls, cut_strategy strategy = cut_chords);
 
 ///<summary>
 ///<para>Trims small sub-regions from target with Cull and merges them to outs</para>
@@ -17,7 +33,7 @@ void removeSmallSections(Region_List &target, grd const &min_width, Region_List
 ///<para>Assumes: target is maximally merged</para>
 ///<para>Fulfills: outs is maximally merged. target is simple, target are otherwise restricted to width</para>
 ///</summary>
-void sizeRestrict(Region_List &target, grd const &min_width, Region_List &outs);
+void sizeRestrict(Region_List &target, grd const &min_width, Region_List &outs, cut_strategy strategy = cut_chords);
 
 ///<summary>
 ///<para>Allocates a novel set of sub-regions, from a set of regions, as defined by a boundary.</para>
@@ -35,6 +51,14 @@ Region_List allocateBoundaryFrom(FLL<Pgrd> const &boundary, Region_List &set);
 ///</summary>
 void allocateBoundaryFromInto(FLL<Pgrd> const &boundary, Region_List &set, Region_List &result);
 
+///<summary>
+///<para>Allocates a novel set of sub-regions, from a set of regions, as defined by every boundary in turn. The set is merged once for the whole batch.</para>
+///<para>&#160;</para>
+///<para>Assumes: -</para>
+///<para>Fulfills: set is maximally merged. result is maximally merged</para>
+///</summary>
+void allocateBoundariesFromInto(FLL<FLL<Pgrd> *> const &boundaries, Region_List &set, Region_List &result);
+
 ///<summary>
 ///<para>Allocates a novel set of sub-regions, from a set of regions, as defined by a boundary. Then trims small sub-regions with Cull and returns them to the originating set of regions.</para>
 ///<para>&#160;</para>
@@ -0,0 +1,40 @@
+#include "Grid_Width.h"
+
+void Caliper_Width::build(SVL<Pgrd, 32> & points) {
+	direct = directions.size() < direct_limit;
+
+	if (direct) {
+		hull = std::move(points);
+		return;
+	}
+
+	convexHull(points, hull);
+
+	std::sort(directions.data(), directions.data() + directions.size());
+}
+
+grd Caliper_Width::minimum() const {
+	grd diameter = 0;
+	bool found = false;
+
+	sweep([&](grd const & width) {
+		if (width < diameter || !found) {
+			found = true;
+			diameter = width;
+		}
+		return true;
+	});
+
+	return diameter;
+}
+
+bool Caliper_Width::below(grd const & thresh) const {
+	bool result = false;
+
+	sweep([&](grd const & width) {
+		result = width < thresh;
+		return !result;
+	});
+
+	return result;
+}
@@ -0,0 +1,179 @@
+#pragma once
+#include "Grid_Region.h"
+#include <algorithm>
+
+/*
+
+Contains the width of a shape across the directions of its own edges, found with rotating calipers
+
+the width across a direction only depends on the extreme points of the shape, so only the convex hull is walked
+the edge directions are visited in angular order, and the extreme points on either side only ever advance
+around the hull as they turn, making the sweep linear after sorting
+
+widths are measured exactly as linear_offset does, the calipers only decide which points to measure
+small shapes, where sorting costs more than it saves, measure every point against every direction instead
+only positions are read, so separate shapes may be measured on separate threads
+
+*/
+
+//appends to hull the convex hull of points, counter clockwise, without collinear points
+//points is reordered
+template <int _N>
+void convexHull(SVL<Pgrd, _N> & points, SVL<Pgrd, _N> & hull);
+
+class Caliper_Width {
+	struct direction {
+		Pgrd vector;
+		grd length;
+		double angle;
+
+		bool operator<(direction const & target) const {
+			return angle < target.angle;
+		}
+	};
+
+	//below this many edges every point is measured directly
+	enum : int { direct_limit = 24 };
+
+	//the convex hull, or every point when measured directly
+	SVL<Pgrd, 32> hull;
+	SVL<direction, 32> directions;
+	bool direct;
+
+	void build(SVL<Pgrd, 32> & points);
+
+	//sweeps the directions, in angular order, until visit returns false
+	template <class _V>
+	void sweep(_V const & visit) const;
+
+public:
+	//measures across the directions of the edges, edges is any range of edges
+	template <class _R>
+	explicit Caliper_Width(_R const & edges);
+
+	//the smallest width across any edge direction, 0 without any edges
+	grd minimum() const;
+
+	//whether the width across some edge direction is below thresh, stops at the first found
+	bool below(grd const & thresh) const;
+};
+
+template <class _R>
+Caliper_Width::Caliper_Width(_R const & edges) {
+	SVL<Pgrd, 32> points;
+
+	for (auto edge : edges) {
+		Pgrd const & start = edge->getStart()->getPosition();
+
+		points.append(start);
+
+		//matches the edge's cached vector and length, which are not read so threads never fill the cache
+		direction product;
+		product.vector = edge->getEnd()->getPosition() - start;
+		product.length = product.vector.Size();
+		product.angle = std::atan2(product.vector.Y.value(), product.vector.X.value());
+
+		//an empty edge has no direction
+		if (product.length == 0)
+			continue;
+
+		directions.append(product);
+	}
+
+	build(points);
+}
+
+template <class _V>
+void Caliper_Width::sweep(_V const & visit) const {
+	int const size = hull.size();
+
+	if (size == 0)
+		return;
+
+	bool first = true;
+	int high = 0;
+	int low = 0;
+
+	for (auto const & focus : directions) {
+		auto offset = [&](int index) {
+			return linear_offset(focus.vector, focus.length, hull[index]);
+		};
+
+		if (direct) {
+			grd min_offset = offset(0);
+			grd max_offset = min_offset;
+
+			for (int index = 1; index < size; index++) {
+				grd const raw = offset(index);
+
+				if (min_offset > raw)
+					min_offset = raw;
+				if (max_offset < raw)
+					max_offset = raw;
+			}
+
+			if (!visit(max_offset - min_offset))
+				return;
+
+			continue;
+		}
+
+		if (first) {
+			//the first direction finds its extremes directly
+			for (int index = 1; index < size; index++) {
+				if (offset(index) > offset(high))
+					high = index;
+				if (offset(index) < offset(low))
+					low = index;
+			}
+			first = false;
+		}
+		else {
+			//turning counter clockwise moves both extremes counter clockwise, the bound guards flat hulls
+			for (int step = 0; step < size && offset((high + 1) % size) >= offset(high); step++)
+				high = (high + 1) % size;
+			for (int step = 0; step < size && offset((low + 1) % size) <= offset(low); step++)
+				low = (low + 1) % size;
+		}
+
+		if (!visit(offset(high) - offset(low)))
+			return;
+	}
+}
+
+template <int _N>
+void convexHull(SVL<Pgrd, _N> & points, SVL<Pgrd, _N> & hull) {
+	std::sort(points.data(), points.data() + points.size(), [](Pgrd const & a, Pgrd const & b) {
+		return a.X < b.X || (a.X == b.X && a.Y < b.Y);
+	});
+
+	int const first = hull.size();
+
+	//monotone chain, the lower chain left to right then the upper chain right to left
+	//a point is kept only when it turns strictly left, by the exact sign of orient2d
+	for (int index = 0; index < points.size(); index++) {
+		if (index > 0 && points[index] == points[index - 1])
+			continue;
+
+		while (hull.size() - first >= 2 && orient2d(hull[hull.size() - 2], hull[hull.size() - 1], points[index]) <= 0)
+			hull.removeAt(hull.size() - 1);
+
+		hull.append(points[index]);
+	}
+
+	int const lower = hull.size();
+
+	for (int index = points.size() - 2; index >= 0; index--) {
+		if (points[index] == points[index + 1])
+			continue;
+
+		while (hull.size() - lower >= 1 && orient2d(hull[hull.size() - 2], hull[hull.size() - 1], points[index]) <= 0)
+			hull.removeAt(hull.size() - 1);
+
+		hull.append(points[index]);
+	}
+
+	//the upper chain ends on the first point
+	if (hull.size() - first > 1)
+		hull.removeAt(hull.size() - 1);
+}
@@ -0,0 +1,208 @@
+#pragma once
+#include <new>
+
+/*
+
+Contains definition for a typed slab pool
+storage is handed out as fixed slots within slabs that never move, so element addresses are stable
+released slots are threaded onto a free list, making acquisition and release O(1)
+every slot carries a handle (its index across all slabs) which stays valid until the slot is released
+and a generation, counting its releases, which tells a reused handle from the element it once named
+
+the pool only manages storage, construction and destruction is left to the owner
+
+*/
+
+template <class _T, int _SlabSize = 256>
+class Pool {
+	struct Slot {
+		//must remain the first member, elements are converted back to slots by address
+		alignas(_T) unsigned char storage[sizeof(_T)];
+
+		Slot * next_free;
+		unsigned handle;
+		unsigned generation;
+		bool live;
+	};
+
+	Slot ** slabs;
+	int slab_count;
+	int slab_capacity;
+
+	Slot * free_list;
+	int live_count;
+
+	static Slot * toSlot(_T const * element) {
+		return reinterpret_cast<Slot *>(const_cast<_T *>(element));
+	}
+
+	void grow() {
+		if (slab_count == slab_capacity) {
+			int const capacity = slab_capacity == 0 ? 4 : slab_capacity * 2;
+			Slot ** novel = new Slot*[capacity];
+
+			for (int index = 0; index < slab_count; index++)
+				novel[index] = slabs[index];
+
+			delete[] slabs;
+			slabs = novel;
+			slab_capacity = capacity;
+		}
+
+		Slot * slab = static_cast<Slot *>(::operator new(sizeof(Slot) * _SlabSize));
+		unsigned const base = (unsigned)(slab_count * _SlabSize);
+
+		//thread in reverse so slots are handed out in address order
+		for (int index = _SlabSize - 1; index >= 0; index--) {
+			slab[index].next_free = free_list;
+			slab[index].handle = base + index;
+			slab[index].generation = 0;
+			slab[index].live = false;
+			free_list = slab + index;
+		}
+
+		slabs[slab_count] = slab;
+		slab_count++;
+	}
+
+public:
+	typedef unsigned Handle;
+
+	class Pool_iterator {
+		Pool const * relevant;
+		int slot;
+
+		void skipDead() {
+			int const capacity = relevant->capacity();
+			while (slot < capacity && !relevant->slotAt(slot)->live)
+				slot++;
+		}
+
+	public:
+		Pool_iterator(Pool const * r, int s) {
+			relevant = r;
+			slot = s;
+			skipDead();
+		}
+
+		Pool_iterator & operator++() {
+			slot++;
+			skipDead();
+			return *this;
+		}
+		bool operator==(Pool_iterator const & target) const {
+			return slot == target.slot;
+		}
+		bool operator!=(Pool_iterator const & target) const {
+			return slot != target.slot;
+		}
+
+		_T * operator*() const {
+			return reinterpret_cast<_T *>(relevant->slotAt(slot)->storage);
+		}
+	};
+
+	Pool() {
+		slabs = nullptr;
+		slab_count = 0;
+		slab_capacity = 0;
+
+		free_list = nullptr;
+		live_count = 0;
+	}
+	~Pool() {
+		clear();
+	}
+
+	//slabs are never copied or moved, addresses handed out must remain valid
+	Pool(Pool &&) = delete;
+	Pool(Pool const &) = delete;
+
+	//returns uninitialized storage for one element
+	_T * acquire() {
+		if (free_list == nullptr)
+			grow();
+
+		Slot * result = free_list;
+		free_list = result->next_free;
+
+		result->live = true;
+		live_count++;
+
+		return reinterpret_cast<_T *>(result->storage);
+	}
+
+	//returns an element's storage to the pool, the element must already be destroyed
+	void release(_T * element) {
+		Slot * target = toSlot(element);
+
+		target->live = false;
+		target->generation++;
+		target->next_free = free_list;
+		free_list = target;
+
+		live_count--;
+	}
+
+	Handle handleOf(_T const * element) const {
+		return toSlot(element)->handle;
+	}
+
+	unsigned generationOf(_T const * element) const {
+		return toSlot(element)->generation;
+	}
+
+	//the releases of the slot behind a handle, so far
+	unsigned generationAt(Handle handle) const {
+		return slotAt((int)handle)->generation;
+	}
+
+	//returns the live element for a handle, nullptr if released or out of range
+	_T * fromHandle(Handle handle) const {
+		if (handle >= (Handle)capacity())
+			return nullptr;
+
+		Slot * target = slotAt((int)handle);
+		if (!target->live)
+			return nullptr;
+
+		return reinterpret_cast<_T *>(target->storage);
+	}
+
+	//the number of live elements
+	int size() const {
+		return live_count;
+	}
+
+	//the number of slots, one past the largest possible handle
+	int capacity() const {
+		return slab_count * _SlabSize;
+	}
+
+	Pool_iterator begin() const {
+		return Pool_iterator(this, 0);
+	}
+	Pool_iterator end() const {
+		return Pool_iterator(this, capacity());
+	}
+
+	//releases all slabs at once, live elements must already be destroyed
+	void clear() {
+		for (int index = 0; index < slab_count; index++)
+			::operator delete(slabs[index]);
+
+		delete[] slabs;
+
+		slabs = nullptr;
+		slab_count = 0;
+		slab_capacity = 0;
+
+		free_list = nullptr;
+		live_count = 0;
+	}
+
+private:
+	Slot * slotAt(int slot) const {
+		return slabs[slot / _SlabSize] + (slot % _SlabSize);
+	}
+};
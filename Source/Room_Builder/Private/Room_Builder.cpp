@@ -1,20 +1,27 @@
 // Copyright 1998-2017 Epic Games, Inc. All Rights Reserved.
 
 #include "Room_Builder.h"
+#include "CoreMinimal.h"
+#include "Grid_Log.h"
 
 #define LOCTEXT_NAMESPACE "FRoom_BuilderModule"
 
+static void UnrealLogSink(char const * message)
+{
+	UE_LOG(LogTemp, Warning, TEXT("%s"), UTF8_TO_TCHAR(message));
+}
+
 void FRoom_BuilderModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
-	
+	setGridLogSink(UnrealLogSink);
 }
 
 void FRoom_BuilderModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
-	
+	setGridLogSink(nullptr);
 }
 
 #undef LOCTEXT_NAMESPACE
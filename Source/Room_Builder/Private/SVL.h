@@ -0,0 +1,415 @@
+#pragma once
+#include <new>
+#include <utility>
+
+/*
+
+Contains definition for a contiguous small vector list template
+the first _N elements are stored inline, larger lists move to a single heap block
+mirrors the interface of FLL, so lists can be swapped between the two
+iterators are index based, and remain valid while the list grows
+
+*/
+
+template <class _T, int _N = 8>
+class SVL {
+	static_assert(_N > 0, "SVL requires room for at least one inline element");
+
+	alignas(_T) unsigned char local[sizeof(_T) * _N];
+
+	_T * items;
+	int length;
+	int capacity;
+
+	_T * localItems() {
+		return reinterpret_cast<_T *>(local);
+	}
+	bool isLocal() const {
+		return items == reinterpret_cast<_T const *>(local);
+	}
+
+	void reserveFor(int count) {
+		if (count <= capacity)
+			return;
+
+		int size = capacity * 2;
+		if (size < count)
+			size = count;
+
+		_T * novel = static_cast<_T *>(::operator new(sizeof(_T) * size));
+
+		for (int index = 0; index < length; index++) {
+			new (novel + index) _T(std::move(items[index]));
+			items[index].~_T();
+		}
+
+		if (!isLocal())
+			::operator delete(items);
+
+		items = novel;
+		capacity = size;
+	}
+
+	//opens a gap at index, the gap is left unconstructed
+	void openAt(int index) {
+		reserveFor(length + 1);
+
+		if (index == length)
+			return;
+
+		new (items + length) _T(std::move(items[length - 1]));
+		for (int focus = length - 1; focus > index; focus--)
+			items[focus] = std::move(items[focus - 1]);
+
+		items[index].~_T();
+	}
+
+	void releaseStorage() {
+		if (!isLocal())
+			::operator delete(items);
+
+		items = localItems();
+		capacity = _N;
+	}
+
+	//takes the contents of target, leaving it empty
+	void take(SVL<_T, _N> & target) {
+		if (!target.isLocal()) {
+			items = target.items;
+			length = target.length;
+			capacity = target.capacity;
+
+			target.items = target.localItems();
+			target.length = 0;
+			target.capacity = _N;
+		}
+		else {
+			for (int index = 0; index < target.length; index++)
+				new (items + index) _T(std::move(target.items[index]));
+
+			length = target.length;
+			target.clear();
+		}
+	}
+
+public:
+
+	class SVL_iterator {
+		SVL * relevant;
+		int focus;
+
+	public:
+		SVL_iterator() {
+			relevant = nullptr;
+			focus = 0;
+		}
+		SVL_iterator(SVL * r, int v) {
+			relevant = r;
+			focus = v;
+		}
+
+		SVL_iterator & operator++() {
+			focus++;
+
+			return *this;
+		}
+		bool operator==(SVL_iterator const & target) const {
+			return focus == target.focus;
+		}
+		bool operator!=(SVL_iterator const & target) const {
+			return focus != target.focus;
+		}
+
+		_T & operator*() const {
+			return relevant->items[focus];
+		}
+		_T & operator->() const {
+			return relevant->items[focus];
+		}
+
+		SVL_iterator next() const {
+			return SVL_iterator(relevant, focus + 1);
+		}
+		SVL_iterator cyclic_next() const {
+			if (focus + 1 == relevant->length) {
+				return SVL_iterator(relevant, 0);
+			}
+			else {
+				return SVL_iterator(relevant, focus + 1);
+			}
+		}
+
+		int index() const {
+			return focus;
+		}
+	};
+
+	class SVL_iterator_c {
+		SVL const * relevant;
+		int focus;
+
+	public:
+		SVL_iterator_c() {
+			relevant = nullptr;
+			focus = 0;
+		}
+		SVL_iterator_c(SVL const * r, int v) {
+			relevant = r;
+			focus = v;
+		}
+
+		SVL_iterator_c & operator++() {
+			focus++;
+
+			return *this;
+		}
+		bool operator==(SVL_iterator_c const & target) const {
+			return focus == target.focus;
+		}
+		bool operator!=(SVL_iterator_c const & target) const {
+			return focus != target.focus;
+		}
+
+		_T const & operator*() const {
+			return relevant->items[focus];
+		}
+		_T const & operator->() const {
+			return relevant->items[focus];
+		}
+
+		SVL_iterator_c next() const {
+			return SVL_iterator_c(relevant, focus + 1);
+		}
+		SVL_iterator_c cyclic_next() const {
+			if (focus + 1 == relevant->length) {
+				return SVL_iterator_c(relevant, 0);
+			}
+			else {
+				return SVL_iterator_c(relevant, focus + 1);
+			}
+		}
+
+		int index() const {
+			return focus;
+		}
+	};
+
+	SVL() {
+		items = localItems();
+		length = 0;
+		capacity = _N;
+	}
+	~SVL() {
+		clear();
+		releaseStorage();
+	}
+	SVL(SVL<_T, _N> && reference) : SVL() {
+		take(reference);
+	}
+	SVL(SVL<_T, _N> const & reference) : SVL() {
+		append(reference);
+	}
+
+	SVL<_T, _N> & operator=(SVL<_T, _N> && reference) {
+		if (this != &reference) {
+			clear();
+			releaseStorage();
+			take(reference);
+		}
+
+		return *this;
+	}
+	SVL<_T, _N> & operator=(SVL<_T, _N> const & reference) {
+		if (this != &reference) {
+			clear();
+			append(reference);
+		}
+
+		return *this;
+	}
+
+	//inserts at the front, as FLL does
+	void push(_T value) {
+		openAt(0);
+		new (items) _T(std::move(value));
+
+		length++;
+	}
+
+	void append(_T value) {
+		reserveFor(length + 1);
+		new (items + length) _T(std::move(value));
+
+		length++;
+	}
+	void append(SVL<_T, _N> const & reference) {
+		reserveFor(length + reference.length);
+
+		for (int index = 0; index < reference.length; index++)
+			new (items + length + index) _T(reference.items[index]);
+
+		length += reference.length;
+	}
+
+	//constructs an element in place at the end
+	template <class... _Args>
+	_T & emplace(_Args&&... args) {
+		reserveFor(length + 1);
+		new (items + length) _T(std::forward<_Args>(args)...);
+
+		length++;
+
+		return items[length - 1];
+	}
+
+	//reserves room for count elements in total
+	void reserve(int count) {
+		reserveFor(count);
+	}
+
+	//returns the element at the front, undefined behavior if empty
+	_T pop() {
+		_T product = std::move(items[0]);
+
+		removeAt(0);
+
+		return product;
+	}
+
+	bool empty() const {
+		return length == 0;
+	}
+	bool contains(_T const & search) const {
+		for (int index = 0; index < length; index++)
+			if (items[index] == search) return true;
+
+		return false;
+	}
+
+	SVL_iterator begin() {
+		return SVL_iterator(this, 0);
+	}
+	SVL_iterator end() {
+		return SVL_iterator(this, length);
+	}
+
+	SVL_iterator_c begin() const {
+		return SVL_iterator_c(this, 0);
+	}
+	SVL_iterator_c end() const {
+		return SVL_iterator_c(this, length);
+	}
+
+	_T const & last() const {
+		return items[length - 1];
+	}
+
+	SVL<_T, _N> reverse() const {
+		SVL<_T, _N> product;
+
+		product.reserveFor(length);
+
+		for (int index = length - 1; index >= 0; index--)
+			product.append(items[index]);
+
+		return product;
+	}
+
+	//removes the element at index, preserving the order of the rest
+	void removeAt(int index) {
+		for (int focus = index; focus < length - 1; focus++)
+			items[focus] = std::move(items[focus + 1]);
+
+		length--;
+		items[length].~_T();
+	}
+
+	bool remove(_T const & search) {
+		for (int index = 0; index < length; index++) {
+			if (items[index] == search) {
+				removeAt(index);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	int removeAll(_T const & search) {
+		int kept = 0;
+
+		for (int index = 0; index < length; index++) {
+			if (!(items[index] == search)) {
+				if (kept != index)
+					items[kept] = std::move(items[index]);
+				kept++;
+			}
+		}
+
+		int const count = length - kept;
+
+		for (int index = kept; index < length; index++)
+			items[index].~_T();
+
+		length = kept;
+
+		return count;
+	}
+
+	//appends the target list, and empties it
+	void absorb(SVL<_T, _N> & target) {
+		if (&target == this || target.length == 0)
+			return;
+
+		if (length == 0) {
+			releaseStorage();
+			take(target);
+			return;
+		}
+
+		reserveFor(length + target.length);
+
+		for (int index = 0; index < target.length; index++)
+			new (items + length + index) _T(std::move(target.items[index]));
+
+		length += target.length;
+
+		target.clear();
+	}
+
+	int size() const {
+		return length;
+	}
+
+	void qInsert(_T value, bool(*compare)(_T, _T)) {
+		int index = 0;
+
+		while (index < length && !compare(items[index], value))
+			index++;
+
+		openAt(index);
+		new (items + index) _T(std::move(value));
+
+		length++;
+	}
+	void clear() {
+		for (int index = 0; index < length; index++)
+			items[index].~_T();
+
+		length = 0;
+	}
+
+	_T & operator[](int index) {
+		return items[index];
+	}
+	_T const & operator[](int index) const {
+		return items[index];
+	}
+
+	_T * data() {
+		return items;
+	}
+	_T const * data() const {
+		return items;
+	}
+};
@@ -1,7 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "room_description_builder.h"
-#include "Grid_Tools.h"
+#include "Grid_Building.h"
 #include "Algo/Reverse.h"
 #include "DrawDebugHelpers.h"
 #include "ConstructorHelpers.h"
@@ -13,10 +13,11 @@
 
 
 FVector2D convert(Pgrd const &target) {
-	return FVector2D(target.X.n * 10, target.Y.n * 10);
+	return FVector2D(target.X.value() * 10, target.Y.value() * 10);
 }
 
-TArray<FVector2D> convert(FLL<Pgrd> const &target) {
+template <class _L>
+TArray<FVector2D> convert(_L const &target) {
 	TArray<FVector2D> result;
 
 	for (auto x : target)
@@ -98,9 +99,7 @@ PBox getBounds(Region<Pgrd> * target) {
 	result.Min = result.Max;
 
 	for(auto boundary : target->getBounds()){
-		auto points = boundary->getLoopPoints();
-
-		for (auto point : points) {
+		for (auto const & point : boundary->loopPoints()) {
 			result.Min.X = FMath::Min(result.Min.X, point.X);
 			result.Min.Y = FMath::Min(result.Min.Y, point.Y);
 			result.Max.X = FMath::Max(result.Max.X, point.X);
@@ -255,20 +254,14 @@ void Aroom_description_builder::ActivateMeshComponent(UProceduralMeshComponent *
 void generateInsetPoints(Edge<Pgrd> const * target, grd const & distance, 
 	Pgrd & result_A, Pgrd & result_B) {
 
-	Pgrd const previous = target->getLast()->getStart()->getPosition();
 	Pgrd const A = target->getStart()->getPosition();
 	Pgrd const B = target->getEnd()->getPosition();
-	Pgrd const next = target->getNext()->getEnd()->getPosition();
-
-	Pgrd A_last = previous - A;
-	Pgrd A_next = B - A;
-	Pgrd B_last = A - B;
-	Pgrd B_next = next - B;
 
-	A_last.Normalize();
-	A_next.Normalize();
-	B_last.Normalize();
-	B_next.Normalize();
+	//directions are cached on the edges
+	Pgrd const A_last = Pgrd(0, 0) - target->getLast()->getDirection();
+	Pgrd const A_next = target->getDirection();
+	Pgrd const B_last = Pgrd(0, 0) - A_next;
+	Pgrd const B_next = target->getNext()->getDirection();
 	
 	{
 		result_A = A_last + A_next;
@@ -310,14 +303,28 @@ void generateInsetPoints(Edge<Pgrd> const * target, grd const & distance,
 
 }
 
-FLL<Pgrd> generateInsetPoints(Face<Pgrd> * target, grd const & distance) {
+//insets a loop, given as any forward range of its points
+template <class _L>
+FLL<Pgrd> generateInsetPoints(_L const & loop, grd const & distance) {
 
 	FLL<Pgrd> result;
 
-	for (auto edge : target->getLoopEdges()) {
-		Pgrd const previous = edge->getLast()->getStart()->getPosition();
-		Pgrd const A = edge->getStart()->getPosition();
-		Pgrd const B = edge->getEnd()->getPosition();
+	auto const first = loop.begin();
+	auto const end = loop.end();
+
+	if (first == end)
+		return result;
+
+	Pgrd previous;
+	for (auto focus = first; focus != end; ++focus)
+		previous = *focus;
+
+	for (auto focus = first; focus != end; ++focus) {
+		auto after = focus;
+		++after;
+
+		Pgrd const A = *focus;
+		Pgrd const B = after == end ? *first : *after;
 
 		Pgrd A_last = previous - A;
 		Pgrd A_next = B - A;
@@ -343,6 +350,8 @@ FLL<Pgrd> generateInsetPoints(Face<Pgrd> * target, grd const & distance) {
 		inset += A;
 
 		result.append(inset);
+
+		previous = A;
 	}
 
 	return result;
@@ -562,8 +571,9 @@ void Aroom_description_builder::CreateWindowSegment(Edge<Pgrd> const * target, f
 
 }
 
-void Aroom_description_builder::CreateFloorAndCeiling(Region<Pgrd> * source, float bottom, float top) {
-	auto Border = toFVector(generateInsetPoints(source->getBounds().last(), grd(wall_thickness/2)));
+void Aroom_description_builder::CreateFloorAndCeiling(Baked_DCEL<Pgrd>::Region_View source, float bottom, float top) {
+	auto outer = source[source.getBounds().size() - 1];
+	auto Border = toFVector(generateInsetPoints(outer.loopPoints(), grd(wall_thickness/2)));
 
 	Border = tri_utils::Reverse(Border);
 
@@ -631,12 +641,12 @@ void Aroom_description_builder::CreateWallSections(Region<Pgrd> * source, float
 			Region<Pgrd> * op = edge->getInv()->getFace()->getGroup();
 			auto component = CreateMeshComponent();
 
-			if (edge->mark == 0) {
-				if (size <= door_tolerance || op == nullptr || op->mark == 0) {
+			if (edge->getMark() == 0) {
+				if (size <= door_tolerance || op == nullptr || op->getMark() == 0) {
 					CreateWallSegment(edge, bottom, top, component, 0);
 					component->SetMaterial(0, Wall_Material);
-					edge->mark = 1;
-					edge->getInv()->mark = 1;
+					edge->setMark(1);
+					edge->getInv()->setMark(1);
 				}
 				else {
 					auto mid_point = (segment / 2) + A;
@@ -656,17 +666,17 @@ void Aroom_description_builder::CreateWallSections(Region<Pgrd> * source, float
 					component->SetMaterial(1, Wall_Material);
 					component->SetMaterial(2, Wall_Material);
 
-					edge->mark = 1;
-					edge->getInv()->mark = 1;
+					edge->setMark(1);
+					edge->getInv()->setMark(1);
 
-					middle->mark = 2;
-					middle->getInv()->mark = 2;
+					middle->setMark(2);
+					middle->getInv()->setMark(2);
 
-					opposite->mark = 1;
-					opposite->getInv()->mark = 1;
+					opposite->setMark(1);
+					opposite->getInv()->setMark(1);
 				}
 			}
-			else if (edge->mark == 1) {
+			else if (edge->getMark() == 1) {
 				CreateWallSegment(edge, bottom, top, component, 0);
 				component->SetMaterial(0, Wall_Material);
 			}
@@ -690,26 +700,35 @@ void Aroom_description_builder::Create_System(Type_Tracker & tracker) {
 	}
 
 	for (auto room : tracker.Rooms){
-		room->mark = 1;
+		room->setMark(1);
 		cleanRegion(room);
 	}
 
 	for (auto hall : tracker.Halls) {
-		hall->mark = 1;
+		hall->setMark(1);
 		cleanRegion(hall);
 	}
 
+	//floors only read the cleaned structure, walls subdivide it for doors and work on the live DCEL
+	auto baked = tracker.system->bake();
+
+	for (auto room : tracker.Rooms) {
+		CreateFloorAndCeiling(baked.find(room), 0, room_height);
+	}
+
+	for (auto hall : tracker.Halls) {
+		CreateFloorAndCeiling(baked.find(hall), 0, room_height);
+	}
+
 	for (auto ext : tracker.Exteriors) {
 		CreateWallSections(ext, 0, room_height, tracker);
 	}
 
 	for (auto room : tracker.Rooms) {
-		CreateFloorAndCeiling(room, 0, room_height);
 		CreateWallSections(room, 0, room_height, tracker);
 	}
 
 	for (auto hall : tracker.Halls) {
-		CreateFloorAndCeiling(hall, 0, room_height);
 		CreateWallSections(hall, 0, room_height, tracker);
 	}
 }
@@ -822,234 +841,23 @@ FLL<Pgrd> Pick_Generator(grd x, grd y, Pgrd center) {
 }
 
 
-
-Region_List Type_Tracker::createRoom(Region_Suggestion const &suggested) {
-	Region_List final_room_set;
-
-	for (auto boundary : suggested.boundaries) {
-		allocateBoundaryFromInto(*boundary, Nulls, final_room_set);
-	}
-
-	UE_LOG(LogTemp, Warning, TEXT("room smalls"));
-	removeSmallSections(final_room_set, min_room_width, Nulls);
-
-	UE_LOG(LogTemp, Warning, TEXT("hall smalls"));
-	removeSmallSections(Nulls, min_hall_width, Smalls);
-
-	Rooms.append(final_room_set);
-
-	return final_room_set;
-}
-
-Region_List Type_Tracker::createHall(Region_Suggestion const &suggested) {
-	Region_List final_hall_set;
-
-	for (auto boundary : suggested.boundaries) {
-		allocateBoundaryFromInto(*boundary, Nulls, final_hall_set);
-	}
-
-	removeSmallSections(final_hall_set, min_hall_width, Nulls);
-	removeSmallSections(Nulls, min_hall_width, Smalls);
-
-	Halls.append(final_hall_set);
-
-	return final_hall_set;
-}
-
-Region_List Type_Tracker::createNull(Region_Suggestion const &suggested) {
-	Region_List final_null_set;
-
-	for (auto boundary : suggested.boundaries) {
-		allocateBoundaryFromInto(*boundary, Exteriors, final_null_set);
-	}
-
-	removeSmallSections(final_null_set, min_room_width, Exteriors);
-
-	Nulls.append(final_null_set);
-
-	return final_null_set;
-}
-
-bool Region_Suggestion::contains(Pgrd const &test) {
-	for (auto region : boundaries)
-		if (getPointRelation(*region, test) != point_exterior)
-			return true;
-	return false;
-}
-
-void clusterSuggestions(FLL<Region_Suggestion*> &suggested, grd const &tolerance) {
-	auto x = suggested.begin();
-	for (auto x = suggested.begin(); x != suggested.end();++x) {
-		for (auto y = x.next(); y != suggested.end();) {
-			//try and find a pair of centroids within tolerance
-			bool seperate = true;
-			for (auto x_p : x->centroids) {
-				for (auto y_p : y->centroids) {
-					//if ((x_p - y_p).Size() < tolerance)
-					if(x->contains(y_p) && y->contains(x_p)) {
-						seperate = false;
-						break;
-					}
-				}
-				if (!seperate)
-					break;
-			}
-
-
-			//if found, merge all of y into x
-			if (seperate)
-				++y;
-			else {
-				x->centroids.absorb(y->centroids);
-				x->boundaries.absorb(y->boundaries);
-
-				suggested.remove(*y);
-
-				y = x.next();
-			}
-		}
-	}
-}
-
-FLL<Region_Suggestion*> suggestDistribution(Pgrd const &A, Pgrd const &B, grd const &room_width, grd const &room_depth, grd const &min_hall_width, bool start_row = true, bool end_row = true) {
-	FLL<Region_Suggestion*> result;
-
-	Pgrd dir = B - A;
-	dir.Normalize();
-	Pgrd par(dir.Y, -dir.X);
-	par *= (room_depth + min_hall_width / 2);
-
-	grd full_segment = (B - A).Size() + (room_width * 2) - min_hall_width;
-	int rooms = (full_segment / room_width).n;
-	grd segment = full_segment / rooms;
-
-
-	int i = 0;
-	if (!start_row)
-		i++;
-
-	if (!end_row)
-		rooms--;
-
-	for (; i < rooms; i++) {
-		grd offset = (segment * i) - room_width + min_hall_width / 2;
-		Pgrd root = A + (dir * offset);
-
-		{
-
-			Region_Suggestion * suggest = new Region_Suggestion();
-
-			FLL<Pgrd> * bounds = new FLL<Pgrd>();
-			bounds->append(root);
-			bounds->append(root + (dir * segment));
-			bounds->append(root + par + (dir * segment));
-			bounds->append(root + par);
-
-			suggest->boundaries.append(bounds);
-			suggest->centroids.append(root + (par / 2) + (dir * segment / 2));
-
-			result.append(suggest);
-		}
-
-		{
-			Region_Suggestion * suggest = new Region_Suggestion();
-
-			FLL<Pgrd> * bounds = new FLL<Pgrd>();
-			bounds->append(root - par);
-			bounds->append(root - par + (dir * segment));
-			bounds->append(root + (dir * segment));
-			bounds->append(root);
-
-			suggest->boundaries.append(bounds);
-			suggest->centroids.append(root - (par / 2) + (dir * segment / 2));
-
-			result.append(suggest);
-		}
-	}
-
-	return result;
-}
-
-FLL<Pgrd> * wrapSegment(Pgrd const &A, Pgrd const &B, grd const &extent_perp, grd const &extent_ends) {
-	FLL<Pgrd> * result = new FLL<Pgrd>();
-
-	Pgrd dir = B - A;
-	dir.Normalize();
-
-	Pgrd par(-dir.Y, dir.X);
-
-	dir *= extent_ends;
-	par *= extent_perp;
-
-	result->append(A - dir - par);
-	result->append(A - dir + par);
-	result->append(B + dir + par);
-	result->append(B + dir - par);
-
-	return result;
-}
-
 void Aroom_description_builder::buldingFromBlock(Type_Tracker &frame, FLL<rigid_line> &list) {
-	
-	UE_LOG(LogTemp, Warning, TEXT("Building Generation\n\n"));
-	Region_Suggestion null_suggestion;
-
-	for (auto x : list) {
-
-		FLL<Pgrd> * null_boundary = wrapSegment(x.start, x.end, room_depth + min_hall_width / 2, room_depth - min_hall_width / 2);
-
-		null_suggestion.boundaries.append(null_boundary);
-	}
-
-	frame.createNull(null_suggestion);
-
-
-
-	UE_LOG(LogTemp, Warning, TEXT("Hall Generation\n\n\n"));
-	Region_Suggestion hall_suggestion;
-
-	for (auto x : list) {
-
-		FLL<Pgrd> * hall_boundary = wrapSegment(x.start, x.end, hall_width / 2, hall_width / 2);
-
-		hall_suggestion.boundaries.append(hall_boundary);
-	}
-
-	frame.createHall(hall_suggestion);
-
-
-
-	UE_LOG(LogTemp, Warning, TEXT("Stuff Generation\n\n\n"));
-
-	FLL<Region_Suggestion *> room_list;
+	Block_Dimensions dims;
+	dims.room_width = room_width;
+	dims.room_depth = room_depth;
+	dims.hall_width = hall_width;
 
-	for (auto x : list) {
-		auto p = suggestDistribution(x.start, x.end, room_width, room_depth, min_hall_width, x.start_row, x.end_row);
-		room_list.absorb(p);
-	}
-
-	for (auto room_suggestion : room_list) {
-		for (auto p : room_suggestion->centroids)
-			DrawDebugLine(
-				GetWorld(),
-				FVector(convert(p), 10),
-				FVector(convert(p), 20),
-				color_blue,
-				true,
-				-1,
-				0,
-				5
-			);
-	}
+	createBlockNulls(frame, list, dims);
 
-	clusterSuggestions(room_list, room_width);
+	createBlockHalls(frame, list, dims);
 
+	FLL<Region_Suggestion *> room_list = suggestBlockRooms(frame, list, dims);
 
 	UE_LOG(LogTemp, Warning, TEXT("ROOMS\n"));
 	for (auto room_suggestion : room_list) {
 		FColor color(FMath::RandRange(0, 255), FMath::RandRange(0, 255), FMath::RandRange(0, 255));
 		for (auto p : room_suggestion->centroids) {
-			UE_LOG(LogTemp, Warning, TEXT("room at : %f, %f"), p.X.n, p.Y.n);
+			UE_LOG(LogTemp, Warning, TEXT("room at : %f, %f"), p.X.value(), p.Y.value());
 			DrawDebugLine(
 				GetWorld(),
 				FVector(convert(p), 20),
@@ -1062,69 +870,24 @@ void Aroom_description_builder::buldingFromBlock(Type_Tracker &frame, FLL<rigid_
 			);
 		}
 
-		//frame.createRoom(*room_suggestion);
-
-		//for (auto p : room_suggestion->boundaries)
-		//	Draw_Border(convert(*p), 30, GetWorld(), color);
-
 		for(auto r : frame.createRoom(*room_suggestion))
 			for (auto p : r->getBounds())
 				Draw_Border(convert(p->getLoopPoints()), 50, GetWorld(), color);
-	}
-	UE_LOG(LogTemp, Warning, TEXT("SMALLS\n"));
 
-	frame.Smalls.absorb(frame.Nulls);
+		delete room_suggestion;
+	}
 
 	//display leftovers
 	{
 		for (auto n : frame.Smalls)
 			for (auto p : n->getBounds())
 				Draw_Border(convert(p->getLoopPoints()), 60, GetWorld(), FColor(0, 200, 0));
+		for (auto n : frame.Nulls)
+			for (auto p : n->getBounds())
+				Draw_Border(convert(p->getLoopPoints()), 60, GetWorld(), FColor(0, 200, 0));
 	}
 
-	Region_List all_smalls;
-	Region_List smalls;
-
-	for (auto small : frame.Smalls) {
-
-		//filters for neighboring rooms, removes them from frame consideration for potential edits
-		Region_List neighbors = small->getNeighbors();
-		Region_List room_neighbors;
-		for (auto neighbor : neighbors)
-			if (frame.Rooms.remove(neighbor))
-				room_neighbors.append(neighbor);
-
-		Region_List rooms;
-		
-
-		smalls.append(small);
-
-		Region_List novel_smalls;
-		Region_List relevant;
-
-		for (auto potential : room_neighbors) {
-			relevant.append(potential);
-
-			for (auto part : smalls) {
-				if (!merge(potential, part)) {
-					novel_smalls.append(part);
-				}
-			}
-
-			removeSmallSections(relevant, min_room_width, novel_smalls);
-
-			smalls.clear();
-
-			rooms.absorb(relevant);
-			smalls.absorb(novel_smalls);
-		}
-
-		frame.Rooms.absorb(rooms);
-		all_smalls.absorb(smalls);
-	}
-
-	frame.Smalls.clear();
-	frame.Smalls.absorb(all_smalls);
+	resolveBlockSmalls(frame);
 }
 
 //==========================================================================================================
@@ -1155,7 +918,7 @@ void Aroom_description_builder::Main_Generation_Loop() {
 
 	FLL<rigid_line> list;
 	for (auto p : Lines)
-		list.append(rigid_line(p));
+		list.append(rigid_line(Pgrd(p.start.X, p.start.Y), Pgrd(p.end.X, p.end.Y), p.start_row, p.end_row));
 
 	buldingFromBlock(frame, list);
 
@@ -5,18 +5,9 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "ProceduralMeshComponent.h"
-#include "Grid_Region.h"
+#include "Grid_Building.h"
 #include "room_description_builder.generated.h"
 
-//Used to track regions within a DCEL and categorize them
-
-struct Region_Suggestion {
-	FLL<Pgrd> centroids;
-	FLL<FLL<Pgrd> *> boundaries;
-
-	bool contains(Pgrd const &test);
-};
-
 USTRUCT()
 struct FBuild_Line {
 	GENERATED_BODY()
@@ -32,61 +23,6 @@ struct FBuild_Line {
 	bool end_row;
 };
 
-struct rigid_line {
-	Pgrd start;
-	Pgrd end;
-
-	bool start_row;
-	bool end_row;
-
-	rigid_line() {
-
-	}
-	rigid_line(FBuild_Line const &ref) {
-		start = Pgrd(ref.start.X, ref.start.Y);
-		end = Pgrd(ref.end.X, ref.end.Y);
-
-		start_row = ref.start_row;
-		end_row = ref.end_row;
-	}
-};
-
-struct Type_Tracker {
-	DCEL<Pgrd> * system;
-
-	float min_room_width;
-	float min_hall_width;
-
-	FLL<Region<Pgrd> *> Exteriors;
-	FLL<Region<Pgrd> *> Nulls;
-	FLL<Region<Pgrd> *> Rooms;
-	FLL<Region<Pgrd> *> Halls;
-	FLL<Region<Pgrd> *> Smalls;
-
-	bool isRoom(Region<Pgrd> const * target) {
-		for (auto room : Rooms) {
-			if (room == target) {
-				return true;
-			}
-		}
-		return false;
-	}
-
-	Type_Tracker(DCEL<Pgrd> * sys, float room, float hall) {
-		system = sys;
-
-		Exteriors.append(sys->region());
-
-		min_room_width = room;
-		min_hall_width = hall;
-	}
-
-	FLL<Region<Pgrd> *> createRoom(Region_Suggestion const &suggested);
-	FLL<Region<Pgrd> *> createHall(Region_Suggestion const &suggested);
-	FLL<Region<Pgrd> *> createNull(Region_Suggestion const &suggested);
-};
-
-
 UCLASS()
 class ROOM_BUILDER_API Aroom_description_builder : public AActor
 {
@@ -159,7 +95,7 @@ public:
 	void CreateDoorSegment(Edge<Pgrd> const * target, float bottom, float top, UProceduralMeshComponent * component, int section_id);
 	void CreateWindowSegment(Edge<Pgrd> const * target, float bottom, float top, UProceduralMeshComponent * component, int section_id);
 
-	void CreateFloorAndCeiling(Region<Pgrd> * source, float bottom, float top);
+	void CreateFloorAndCeiling(Baked_DCEL<Pgrd>::Region_View source, float bottom, float top);
 	void CreateWallSections(Region<Pgrd> * source, float bottom, float top, Type_Tracker & tracker);
 
 	void Create_System(Type_Tracker & tracker);
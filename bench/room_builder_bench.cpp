@@ -0,0 +1,464 @@
+#include "Grid_Batch.h"
+#include "Grid_Building.h"
+#include "Grid_Log.h"
+#include "Grid_Width.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/*
+
+Headless driver for the geometry core
+runs the null, hall, and room allocation pipeline of buildingFromBlock on fixed build line
+layouts and reports per stage timings along with a summary of the produced regions
+
+*/
+
+namespace
+{
+	typedef std::chrono::steady_clock bench_clock;
+
+	double elapsed(bench_clock::time_point start) {
+		return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+	}
+
+	void stderrSink(char const * message) {
+		fprintf(stderr, "%s\n", message);
+	}
+
+	struct scenario {
+		char const * name;
+		void(*populate)(FLL<rigid_line> &);
+	};
+
+	void lineScenario(FLL<rigid_line> &list) {
+		list.append(rigid_line(Pgrd(0, 0), Pgrd(300, 0), true, true));
+	}
+
+	void crossScenario(FLL<rigid_line> &list) {
+		list.append(rigid_line(Pgrd(-200, 0), Pgrd(200, 0), true, true));
+		list.append(rigid_line(Pgrd(0, -200), Pgrd(0, 200), true, true));
+	}
+
+	void blockScenario(FLL<rigid_line> &list) {
+		list.append(rigid_line(Pgrd(0, 0), Pgrd(400, 0), true, true));
+		list.append(rigid_line(Pgrd(400, 0), Pgrd(400, 400), false, true));
+		list.append(rigid_line(Pgrd(400, 400), Pgrd(0, 400), false, true));
+		list.append(rigid_line(Pgrd(0, 400), Pgrd(0, 0), false, false));
+	}
+
+	void gridScenario(FLL<rigid_line> &list) {
+		for (int i = 0; i < 3; i++) {
+			grd offset = i * 300;
+			list.append(rigid_line(Pgrd(-100, offset), Pgrd(700, offset), true, true));
+			list.append(rigid_line(Pgrd(offset, -100), Pgrd(offset, 700), true, true));
+		}
+	}
+
+	scenario const scenarios[] = {
+		{ "line", lineScenario },
+		{ "cross", crossScenario },
+		{ "block", blockScenario },
+		{ "grid", gridScenario },
+	};
+
+	int const scenario_count = sizeof(scenarios) / sizeof(scenarios[0]);
+
+	struct stage_times {
+		double nulls = 0;
+		double halls = 0;
+		double rooms = 0;
+		double smalls = 0;
+	};
+
+	//the enclosed area of a region, clockwise bounds are positive and holes negative
+	double regionArea(Region<Pgrd> * target) {
+		double total = 0;
+		for (auto face : target->getBounds())
+			total += Pgrd::area(face->loopPoints()).value();
+		return total;
+	}
+
+	double listArea(Region_List const &list) {
+		double total = 0;
+		for (auto region : list)
+			total += regionArea(region);
+		return total;
+	}
+
+	double listArea(Baked_DCEL<Pgrd> const &baked, Region_List const &list) {
+		double total = 0;
+		for (auto region : list)
+			for (auto face : baked.find(region).getBounds())
+				total += Pgrd::area(face.loopPoints()).value();
+		return total;
+	}
+
+	//counts the region boundary edges which face a different region, walking pointers
+	int countBorders(Region_List const &list) {
+		int count = 0;
+		for (auto region : list)
+			for (auto edge : region->boundaryEdges())
+				if (edge->getInv()->getFace()->getGroup() != region)
+					count++;
+		return count;
+	}
+
+	//counts the region boundary edges which face a different region, walking the baked snapshot
+	int countBorders(Baked_DCEL<Pgrd> const &baked, Region_List const &list) {
+		int count = 0;
+		for (auto source : list) {
+			auto region = baked.find(source);
+			for (auto face : region.getBounds())
+				for (auto edge : face.loopEdges())
+					if (edge.getInv().getFace().getGroup() != region)
+						count++;
+		}
+		return count;
+	}
+
+	int const read_repeats = 200;
+
+	void runScenario(scenario const &target, int iterations, bool summary) {
+		Block_Dimensions dims;
+		dims.room_width = 54;
+		dims.room_depth = 54;
+		dims.hall_width = 12;
+
+		float const min_room_width = 18;
+		float const min_hall_width = 12;
+
+		FLL<rigid_line> list;
+		target.populate(list);
+
+		stage_times total;
+		double best = -1;
+
+		for (int iteration = 0; iteration < iterations; iteration++) {
+			auto const run_start = bench_clock::now();
+
+			DCEL<Pgrd> * system = new DCEL<Pgrd>();
+			Type_Tracker frame(system, min_room_width, min_hall_width);
+
+			auto stage_start = bench_clock::now();
+			createBlockNulls(frame, list, dims);
+			total.nulls += elapsed(stage_start);
+
+			stage_start = bench_clock::now();
+			createBlockHalls(frame, list, dims);
+			total.halls += elapsed(stage_start);
+
+			stage_start = bench_clock::now();
+			auto room_list = suggestBlockRooms(frame, list, dims);
+			for (auto room_suggestion : room_list) {
+				frame.createRoom(*room_suggestion);
+				delete room_suggestion;
+			}
+			total.rooms += elapsed(stage_start);
+
+			stage_start = bench_clock::now();
+			resolveBlockSmalls(frame);
+			total.smalls += elapsed(stage_start);
+
+			if (summary && iteration == 0) {
+				printf("%-8s regions: rooms %d halls %d smalls %d exteriors %d\n", target.name,
+					frame.Rooms.size(), frame.Halls.size(), frame.Smalls.size(), frame.Exteriors.size());
+				printf("%-8s area:    rooms %.3f halls %.3f smalls %.3f\n", target.name,
+					listArea(frame.Rooms), listArea(frame.Halls), listArea(frame.Smalls));
+				printf("%-8s dcel:    points %d edges %d faces %d regions %d\n", target.name,
+					system->pointCount(), system->edgeCount(), system->faceCount(), system->regionCount());
+
+				//read only consumers, comparing pointer traversal against the baked snapshot
+				stage_start = bench_clock::now();
+				auto baked = system->bake();
+				double const bake_time = elapsed(stage_start);
+
+				int borders = 0;
+				stage_start = bench_clock::now();
+				for (int repeat = 0; repeat < read_repeats; repeat++)
+					borders += countBorders(frame.Rooms);
+				double const pointer_time = elapsed(stage_start) / read_repeats;
+
+				int baked_borders = 0;
+				stage_start = bench_clock::now();
+				for (int repeat = 0; repeat < read_repeats; repeat++)
+					baked_borders += countBorders(baked, frame.Rooms);
+				double const baked_time = elapsed(stage_start) / read_repeats;
+
+				printf("%-8s baked:   points %d edges %d faces %d regions %d  room area %.3f  borders %d/%d\n", target.name,
+					baked.pointCount(), baked.edgeCount(), baked.faceCount(), baked.regionCount(),
+					listArea(baked, frame.Rooms), borders / read_repeats, baked_borders / read_repeats);
+				printf("%-8s reads:   bake %.1f  pointer borders %.2f  baked borders %.2f (us)\n", target.name,
+					bake_time * 1000, pointer_time * 1000, baked_time * 1000);
+			}
+
+			delete system;
+
+			double const run = elapsed(run_start);
+			if (best < 0 || run < best)
+				best = run;
+		}
+
+		printf("%-8s x%d  nulls %.3f  halls %.3f  rooms %.3f  smalls %.3f  mean %.3f  best %.3f (ms)\n",
+			target.name, iterations,
+			total.nulls / iterations, total.halls / iterations, total.rooms / iterations, total.smalls / iterations,
+			(total.nulls + total.halls + total.rooms + total.smalls) / iterations, best);
+	}
+
+	//deterministic coordinates for the kernel passes
+	struct lcg {
+		unsigned state = 12345;
+
+		double next(double range) {
+			state = state * 1103515245u + 12345u;
+			return ((state >> 8) & 0xffff) / 65535.0 * range;
+		}
+	};
+
+	int const kernel_inputs = 1024;
+
+	//times the point and segment primitives the allocation passes are built on
+	void runKernels(int iterations) {
+		lcg random;
+
+		SVL<Pgrd> points;
+		for (int i = 0; i < kernel_inputs * 2; i++)
+			points.append(Pgrd(random.next(400) - 200, random.next(400) - 200));
+
+		//an irregular star, so relation tests walk a loop of realistic length
+		FLL<Pgrd> boundary;
+		int const spokes = 24;
+		for (int i = 0; i < spokes; i++) {
+			double const angle = -6.283185307179586 * i / spokes;
+			double const radius = (i % 2) ? 80 : 160;
+			boundary.append(Pgrd(std::cos(angle) * radius, std::sin(angle) * radius));
+		}
+
+		DCEL<Pgrd> * system = new DCEL<Pgrd>();
+		Face<Pgrd> * face = system->draw(boundary);
+
+		int const passes = iterations * 20;
+
+		int intersects = 0;
+		auto stage_start = bench_clock::now();
+		for (int pass = 0; pass < passes; pass++) {
+			for (int i = 0; i + 3 < kernel_inputs * 2; i += 2) {
+				Pgrd result;
+				if (Pgrd::getIntersect(points[i], points[i + 1], points[i + 2], points[i + 3], result))
+					intersects++;
+			}
+		}
+		double const intersect_time = elapsed(stage_start) / passes / (kernel_inputs - 1);
+
+		int interior = 0;
+		stage_start = bench_clock::now();
+		for (int pass = 0; pass < passes; pass++)
+			for (int i = 0; i < kernel_inputs; i++)
+				if (getPointRelation(*face, points[i]).type == FaceRelationType::point_interior)
+					interior++;
+		double const relation_time = elapsed(stage_start) / passes / kernel_inputs;
+
+		SVL<Pgrd> batch;
+		for (int i = 0; i < kernel_inputs; i++)
+			batch.append(points[i]);
+
+		SVL<FaceRelation> relations;
+		int batch_interior = 0;
+		stage_start = bench_clock::now();
+		for (int pass = 0; pass < passes; pass++) {
+			relations.clear();
+			getPointRelations(*face, batch, relations);
+			for (auto const & relation : relations)
+				if (relation.type == FaceRelationType::point_interior)
+					batch_interior++;
+		}
+		double const batch_time = elapsed(stage_start) / passes / kernel_inputs;
+
+		//each query segment against every edge of the star
+		SVL<Edge<Pgrd> *> edges;
+		face->getLoopEdges(edges);
+
+		int edge_hits = 0;
+		stage_start = bench_clock::now();
+		for (int pass = 0; pass < passes; pass++) {
+			for (int i = 0; i + 1 < kernel_inputs; i += 2) {
+				for (auto edge : edges) {
+					Pgrd result;
+					if (Pgrd::getIntersect(points[i], points[i + 1], edge->getStart()->getPosition(), edge->getEnd()->getPosition(), result))
+						edge_hits++;
+				}
+			}
+		}
+		double const edge_time = elapsed(stage_start) / passes / (kernel_inputs / 2) / edges.size();
+
+		SVL<segment_test> tests;
+		int batch_edge_hits = 0;
+		stage_start = bench_clock::now();
+		for (int pass = 0; pass < passes; pass++) {
+			for (int i = 0; i + 1 < kernel_inputs; i += 2) {
+				tests.clear();
+				getSegmentTests(points[i], points[i + 1], edges, tests);
+				for (auto const & test : tests)
+					if (test.state != segment_apart)
+						batch_edge_hits++;
+			}
+		}
+		double const batch_edge_time = elapsed(stage_start) / passes / (kernel_inputs / 2) / edges.size();
+
+		printf("kernels  getIntersect %.1f  getPointRelation %.1f  getPointRelations %.1f (ns)  hits %d/%d/%d\n",
+			intersect_time * 1000000, relation_time * 1000000, batch_time * 1000000,
+			intersects / passes, interior / passes, batch_interior / passes);
+		printf("kernels  getIntersect per edge %.1f  getSegmentTests per edge %.1f (ns)  hits %d/%d\n",
+			edge_time * 1000000, batch_edge_time * 1000000, edge_hits / passes, batch_edge_hits / passes);
+
+		//widths over a loop long enough for the calipers, against the direct measure over every point
+		FLL<Pgrd> wide;
+		int const wide_spokes = 256;
+		for (int i = 0; i < wide_spokes; i++) {
+			double const angle = -6.283185307179586 * i / wide_spokes;
+			double const radius = (i % 2) ? 150 : 160;
+			wide.append(Pgrd(std::cos(angle) * radius, std::sin(angle) * radius));
+		}
+
+		Face<Pgrd> * wide_face = system->draw(wide);
+		SVL<Edge<Pgrd> *> wide_edges;
+		wide_face->getLoopEdges(wide_edges);
+
+		double width = 0;
+		stage_start = bench_clock::now();
+		for (int pass = 0; pass < passes; pass++)
+			width += Caliper_Width(wide_edges).minimum().value();
+		double const caliper_time = elapsed(stage_start) / passes;
+
+		double direct_width = 0;
+		stage_start = bench_clock::now();
+		for (int pass = 0; pass < passes; pass++) {
+			grd diameter = 0;
+			for (int i = 0; i < wide_edges.size(); i++) {
+				Pgrd const & A = wide_edges[i]->getVector();
+				grd const & A_size = wide_edges[i]->getLength();
+
+				grd min_offset = linear_offset(A, A_size, wide_edges[0]->getStart()->getPosition());
+				grd max_offset = min_offset;
+				for (auto compare : wide_edges) {
+					grd const raw = linear_offset(A, A_size, compare->getStart()->getPosition());
+					if (min_offset > raw)
+						min_offset = raw;
+					if (max_offset < raw)
+						max_offset = raw;
+				}
+				if (i == 0 || max_offset - min_offset < diameter)
+					diameter = max_offset - min_offset;
+			}
+			direct_width += diameter.value();
+		}
+		double const direct_time = elapsed(stage_start) / passes;
+
+		printf("kernels  width %d edges  calipers %.1f  direct %.1f (us)  widths %.3f/%.3f\n",
+			wide_edges.size(), caliper_time * 1000, direct_time * 1000, width / passes, direct_width / passes);
+
+		delete system;
+
+		//a body with a row of teeth, each tooth is cut off along its base, by either cut strategy
+		for (int teeth : { 16, 64 }) {
+			double cut_time[2];
+			int kept[2];
+			int cut[2];
+
+			for (cut_strategy strategy : { cut_chords, cut_widths }) {
+				DCEL<Pgrd> * comb_system = new DCEL<Pgrd>();
+
+				FLL<Pgrd> comb;
+				comb.append(Pgrd(0, 0));
+				comb.append(Pgrd(0, 400));
+				for (int i = 0; i < teeth; i++) {
+					comb.append(Pgrd(60 * i + 15, 400));
+					comb.append(Pgrd(60 * i + 15, 500));
+					comb.append(Pgrd(60 * i + 45, 500));
+					comb.append(Pgrd(60 * i + 45, 400));
+				}
+				comb.append(Pgrd(60 * teeth, 400));
+				comb.append(Pgrd(60 * teeth, 0));
+
+				Region<Pgrd> * body = comb_system->region();
+				body->append(comb_system->draw(comb));
+
+				Region_List targets;
+				targets.append(body);
+				Region_List outs;
+
+				stage_start = bench_clock::now();
+				sizeRestrict(targets, 40, outs, strategy);
+				cut_time[strategy] = elapsed(stage_start);
+
+				kept[strategy] = targets.size();
+				cut[strategy] = outs.size();
+
+				delete comb_system;
+			}
+
+			printf("kernels  cut %d teeth  chords %.3f  widths %.3f (ms)  pieces %d/%d  %d/%d\n", teeth,
+				cut_time[cut_chords], cut_time[cut_widths], kept[cut_chords], cut[cut_chords], kept[cut_widths], cut[cut_widths]);
+		}
+	}
+
+	void usage(char const * name) {
+		printf("usage: %s [--iterations N] [--scenario NAME] [--summary] [--verbose] [--kernels]\n", name);
+		printf("scenarios:");
+		for (int i = 0; i < scenario_count; i++)
+			printf(" %s", scenarios[i].name);
+		printf("\n");
+	}
+}
+
+int main(int argc, char ** argv) {
+	int iterations = 10;
+	char const * selected = nullptr;
+	bool summary = false;
+	bool kernels = false;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--iterations") && i + 1 < argc) {
+			iterations = atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "--scenario") && i + 1 < argc) {
+			selected = argv[++i];
+		}
+		else if (!strcmp(argv[i], "--summary")) {
+			summary = true;
+		}
+		else if (!strcmp(argv[i], "--kernels")) {
+			kernels = true;
+		}
+		else if (!strcmp(argv[i], "--verbose")) {
+			setGridLogSink(stderrSink);
+		}
+		else {
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (iterations < 1)
+		iterations = 1;
+
+	if (kernels)
+		runKernels(iterations);
+
+	bool found = false;
+	for (int i = 0; i < scenario_count; i++) {
+		if (selected == nullptr || !strcmp(selected, scenarios[i].name)) {
+			runScenario(scenarios[i], iterations, summary);
+			found = true;
+		}
+	}
+
+	if (!found) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	return 0;
+}